@@ -0,0 +1,104 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/debug.hpp>
+#include <modm/container/linked_list.hpp>
+#include <modm/container/doubly_linked_list.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+// Counts all heap allocations of the process
+static size_t allocations{0};
+
+void*
+operator new(size_t size)
+{
+	allocations++;
+	if (void* ptr = std::malloc(size)) return ptr;
+	throw std::bad_alloc();
+}
+
+void
+operator delete(void* ptr) noexcept
+{ std::free(ptr); }
+
+void
+operator delete(void* ptr, size_t) noexcept
+{ std::free(ptr); }
+
+// Uses the lists like a message queue, as in the container unit tests: the
+// list is filled to its working size and then one element is removed from the
+// front and one is appended to the back per operation.
+//
+// Every variant prints one line of JSON with the number of heap allocations in
+// steady state and the time per operation:
+// {"list":"linked","allocator":"block","allocations":0,"ns_per_op":12.3}
+
+constexpr size_t working_size = 32;
+constexpr size_t operations = 2'000'000;
+
+struct Message
+{
+	uint16_t identifier;
+	uint8_t payload[14];
+};
+
+template< class List >
+void
+measure(const char* list_name, const char* allocator_name, List& list)
+{
+	for (size_t ii = 0; ii < working_size; ii++)
+		list.append(Message{uint16_t(ii), {}});
+
+	const size_t start_allocations = allocations;
+	const auto start = std::chrono::steady_clock::now();
+	uint32_t checksum{0};
+	for (size_t ii = 0; ii < operations; ii++)
+	{
+		checksum += list.getFront().identifier;
+		list.removeFront();
+		list.append(Message{uint16_t(ii), {}});
+	}
+	const auto diff = std::chrono::steady_clock::now() - start;
+	const size_t steady_allocations = allocations - start_allocations;
+
+	const double ns = std::chrono::duration<double, std::nano>(diff).count() / operations;
+	MODM_LOG_INFO.printf("{\"list\":\"%s\",\"allocator\":\"%s\",\"allocations\":%zu,\"ns_per_op\":%.1f,\"checksum\":%u}\n",
+						 list_name, allocator_name, steady_allocations, ns, checksum);
+}
+
+template< template<typename, typename> class List >
+void
+measureAll(const char* name)
+{
+	{
+		List< Message, modm::allocator::Dynamic<Message> > list;
+		measure(name, "dynamic", list);
+	}
+	{
+		List< Message, modm::allocator::Block<Message, 16> > list;
+		measure(name, "block", list);
+	}
+	{
+		alignas(std::max_align_t) static std::byte storage[working_size * 64];
+		using Allocator = modm::allocator::Block<Message, 16>;
+		List< Message, Allocator > list(Allocator(storage, sizeof(storage)));
+		measure(name, "block_storage", list);
+	}
+}
+
+int
+main()
+{
+	measureAll<modm::LinkedList>("linked");
+	measureAll<modm::DoublyLinkedList>("doubly_linked");
+	return 0;
+}
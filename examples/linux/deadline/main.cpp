@@ -0,0 +1,82 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/debug.hpp>
+#include <modm/processing/timer.hpp>
+
+#include <sys/resource.h>
+
+// Runs the same main loop with a few software timers twice: first polling the
+// timers in a busy loop, then idling until the next deadline in between.
+// Reports the number of loop passes per second, which are the wake-ups of the
+// idle loop, and the used CPU time relative to the wall time.
+//
+// Every variant prints one line of JSON:
+// {"loop":"idle","wakeups_per_s":21.0,"cpu_percent":0.1,"expired":42}
+
+using namespace std::chrono_literals;
+constexpr auto runtime = 2s;
+
+double
+cpuTime()
+{
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+		   (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+template< bool idle >
+void
+benchmark(const char* name)
+{
+	modm::PeriodicTimer blink{100ms};
+	modm::PrecisePeriodicTimer sample{25ms};
+	modm::Timeout timeout{1500ms};
+	modm::TimerWheel wheel;
+	modm::TimerWheel::Timer heartbeat;
+	wheel.startPeriodic(heartbeat, 333ms);
+
+	size_t expired{0};
+	uint32_t loops{0};
+	const double cpu_start = cpuTime();
+	const auto start = modm::PreciseClock::now();
+
+	for (const modm::Timeout end{runtime}; not end.isExpired(); loops++)
+	{
+		expired += blink.execute();
+		expired += sample.execute();
+		expired += timeout.execute();
+		expired += wheel.update();
+
+		if constexpr (idle)
+		{
+			modm::Deadline deadline;
+			deadline.add(blink);
+			deadline.add(sample);
+			deadline.add(timeout);
+			deadline.add(wheel);
+			deadline.add(end);
+			deadline.idle();
+		}
+	}
+
+	const double wall = (modm::PreciseClock::now() - start).count() / 1e6;
+	const double cpu = cpuTime() - cpu_start;
+	MODM_LOG_INFO.printf("{\"loop\":\"%s\",\"wakeups_per_s\":%.1f,\"cpu_percent\":%.1f,\"expired\":%zu}\n",
+						 name, loops / wall, 100 * cpu / wall, expired);
+}
+
+int
+main()
+{
+	benchmark<false>("polled");
+	benchmark<true>("idle");
+	return 0;
+}
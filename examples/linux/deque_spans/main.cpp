@@ -0,0 +1,111 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/debug.hpp>
+#include <modm/container/deque.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+// Streams frames through a byte buffer like a serial driver: the receiver
+// writes a frame into the buffer and the framing code reads it back out into a
+// scratch buffer. The frames are not a divisor of the buffer size, so that
+// they regularly wrap around the end of the buffer.
+//
+// The bulk access copies each frame with at most two calls to memcpy(), whose
+// fixed cost dominates for frames of only a few bytes. Longer frames are
+// copied several times faster than item by item.
+//
+// Every variant prints one line of JSON with the throughput:
+// {"access":"spans","frame":64,"mbyte_per_s":1234.5}
+
+constexpr size_t total = 256'000'000;
+
+using Buffer = modm::BoundedDeque<uint8_t, 1000>;
+
+void
+writeElements(Buffer& buffer, const uint8_t* data, size_t length)
+{
+	for (size_t ii = 0; ii < length; ii++)
+		buffer.append(data[ii]);
+}
+
+void
+readElements(Buffer& buffer, uint8_t* data, size_t length)
+{
+	for (size_t ii = 0; ii < length; ii++)
+	{
+		data[ii] = buffer.getFront();
+		buffer.removeFront();
+	}
+}
+
+void
+writeSpans(Buffer& buffer, const uint8_t* data, size_t length)
+{
+	size_t written{0};
+	for (std::span<uint8_t> span : buffer.getFreeSpans())
+	{
+		const size_t size = std::min(span.size(), length - written);
+		std::memcpy(span.data(), data + written, size);
+		written += size;
+	}
+	buffer.commit(written);
+}
+
+void
+readSpans(Buffer& buffer, uint8_t* data, size_t length)
+{
+	size_t read{0};
+	for (std::span<const uint8_t> span : buffer.getOccupiedSpans())
+	{
+		const size_t size = std::min(span.size(), length - read);
+		std::memcpy(data + read, span.data(), size);
+		read += size;
+	}
+	buffer.consume(read);
+}
+
+template< auto write, auto read >
+void
+measure(const char* access, size_t frame)
+{
+	Buffer buffer;
+	uint8_t input[256];
+	uint8_t output[256];
+	for (size_t ii = 0; ii < sizeof(input); ii++) input[ii] = ii;
+
+	uint32_t checksum{0};
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t bytes = 0; bytes < total; bytes += frame)
+	{
+		write(buffer, input, frame);
+		read(buffer, output, frame);
+		checksum += output[frame - 1];
+		// prevent the compiler from optimizing the copies away
+		asm volatile("" :: "r"(output) : "memory");
+	}
+	const auto diff = std::chrono::steady_clock::now() - start;
+
+	const double seconds = std::chrono::duration<double>(diff).count();
+	MODM_LOG_INFO.printf("{\"access\":\"%s\",\"frame\":%zu,\"mbyte_per_s\":%.1f,\"checksum\":%u}\n",
+						 access, frame, total / seconds / 1e6, (unsigned) checksum);
+}
+
+int
+main()
+{
+	for (const size_t frame : {8, 64, 256})
+	{
+		measure<writeElements, readElements>("elements", frame);
+		measure<writeSpans, readSpans>("spans", frame);
+	}
+	return 0;
+}
@@ -0,0 +1,125 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/debug.hpp>
+#include <modm/container/dynamic_array.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <ratio>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Counts all heap allocations of the process
+static size_t allocations{0};
+
+void*
+operator new(size_t size)
+{
+	allocations++;
+	if (void* ptr = std::malloc(size)) return ptr;
+	throw std::bad_alloc();
+}
+
+void
+operator delete(void* ptr) noexcept
+{ std::free(ptr); }
+
+void
+operator delete(void* ptr, size_t) noexcept
+{ std::free(ptr); }
+
+// Appends elements to many arrays, which are created empty, like collecting
+// results without knowing their number in advance. Large arrays measure the
+// growth strategy, small arrays the inline storage.
+//
+// Every variant prints one line of JSON with the heap allocations and the time
+// per appended element:
+// {"array":"modm","element":"int","size":1000,"allocations_per_array":18.0,"ns_per_append":1.2}
+
+constexpr size_t total = 4'000'000;
+
+template< class T >
+T
+makeElement(size_t ii);
+
+template<>
+uint32_t
+makeElement<uint32_t>(size_t ii)
+{ return ii; }
+
+template<>
+std::string
+makeElement<std::string>(size_t ii)
+{
+	// longer than the small string buffer, so that copies allocate
+	return std::string(32, char('a' + ii % 26));
+}
+
+template< class Array, class T >
+void
+measure(const char* array_name, const char* element_name, size_t size)
+{
+	const size_t arrays = total / size;
+	const T element = makeElement<T>(size);
+	size_t checksum{0};
+
+	allocations = 0;
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t ii = 0; ii < arrays; ii++)
+	{
+		Array array;
+		for (size_t jj = 0; jj < size; jj++)
+		{
+			// copy the element outside of the array
+			T value = element;
+			if constexpr (requires { array.emplace_back(std::move(value)); })
+				array.emplace_back(std::move(value));
+			else
+				array.emplaceBack(std::move(value));
+		}
+		checksum += array.size();
+	}
+	const auto diff = std::chrono::steady_clock::now() - start;
+	// copying a std::string allocates once on its own
+	const size_t array_allocations = allocations - (std::is_same_v<T, std::string> ? arrays * size : 0);
+
+	const double ns = std::chrono::duration<double, std::nano>(diff).count();
+	MODM_LOG_INFO.printf("{\"array\":\"%s\",\"element\":\"%s\",\"size\":%zu,\"allocations_per_array\":%.1f,\"ns_per_append\":%.2f,\"checksum\":%zu}\n",
+						 array_name, element_name, size, double(array_allocations) / arrays, ns / (arrays * size), checksum);
+}
+
+template< class T, std::size_t N = 0, class Growth = std::ratio<3, 2> >
+struct Array : public modm::DynamicArray<T, modm::allocator::Dynamic<T>, N, Growth>
+{
+	std::size_t size() const { return this->getSize(); }
+};
+
+template< class T >
+void
+measureAll(const char* element_name)
+{
+	for (const size_t size : {4, 1000})
+	{
+		measure<std::vector<T>, T>("std::vector", element_name, size);
+		measure<Array<T>, T>("modm", element_name, size);
+		measure<Array<T, 0, std::ratio<2>>, T>("modm-growth-2", element_name, size);
+		measure<Array<T, 8>, T>("modm-inline-8", element_name, size);
+	}
+}
+
+int
+main()
+{
+	measureAll<uint32_t>("int");
+	measureAll<std::string>("string");
+	return 0;
+}
@@ -0,0 +1,133 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/debug.hpp>
+#include <modm/processing.hpp>
+#include <chrono>
+
+// Compares running the same resumable driver from protothreads and from fibers
+// with modm::fiber::await(). Each of the readers calls a driver that has to be
+// polled a few times before it returns, like an I2C transfer in progress.
+
+constexpr size_t readers = 4;
+constexpr uint32_t reads = 100'000;
+
+/// Resumable driver that waits for a number of polls before it returns.
+class Driver : public modm::NestedResumable<1>
+{
+public:
+	modm::ResumableResult<uint8_t>
+	read(uint8_t polls)
+	{
+		RF_BEGIN();
+		remaining = polls;
+		RF_WAIT_WHILE(remaining-- > 0);
+		RF_END_RETURN(uint8_t(polls));
+	}
+
+private:
+	uint8_t remaining;
+};
+
+Driver drivers[readers];
+uint8_t polls;
+volatile uint32_t sink;
+
+class Reader : public modm::pt::Protothread
+{
+public:
+	Driver* driver;
+	uint32_t count;
+
+	bool
+	run()
+	{
+		PT_BEGIN();
+		for (count = 0; count < reads; count++)
+			sink = sink + PT_CALL(driver->read(polls));
+		PT_END();
+	}
+};
+
+Reader threads[readers];
+
+// Calling into the C library on hosted requires larger stacks
+modm::fiber::Stack<8192> stacks[readers];
+
+template< class Function >
+uint32_t
+measure(Function&& function)
+{
+	const auto start = std::chrono::steady_clock::now();
+	function();
+	const auto diff = std::chrono::steady_clock::now() - start;
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(diff).count() / (readers * reads);
+}
+
+uint32_t
+protothreads()
+{
+	return measure([]
+	{
+		for (size_t ii = 0; ii < readers; ii++)
+		{
+			threads[ii].driver = &drivers[ii];
+			threads[ii].restart();
+		}
+		bool running{true};
+		while (running)
+		{
+			running = false;
+			for (auto& thread : threads) running |= thread.run();
+		}
+	});
+}
+
+uint32_t
+fibers()
+{
+	// Fibers must not be copied, so construct them in place
+	alignas(modm::Fiber) uint8_t storage[readers][sizeof(modm::Fiber)];
+	for (size_t ii = 0; ii < readers; ii++)
+	{
+		new (storage[ii]) modm::Fiber(stacks[ii], [ii]
+		{
+			for (uint32_t count = 0; count < reads; count++)
+				sink = sink + modm::fiber::await([ii]{ return drivers[ii].read(polls); });
+		});
+	}
+	return measure([] { modm::fiber::Scheduler::run(); });
+}
+
+uint32_t
+blocking()
+{
+	return measure([]
+	{
+		for (auto& driver : drivers)
+			for (uint32_t count = 0; count < reads; count++)
+				sink = sink + RF_CALL_BLOCKING(driver.read(polls));
+	});
+}
+
+int
+main()
+{
+	polls = 0;
+	MODM_LOG_INFO << "polls=0: RF_CALL_BLOCKING " << blocking() << "ns, protothread "
+				  << protothreads() << "ns, fiber await " << fibers() << "ns per read" << modm::endl;
+
+	for (uint8_t count : {1, 4})
+	{
+		polls = count;
+		MODM_LOG_INFO << "polls=" << count << ": protothread " << protothreads()
+					  << "ns, fiber await " << fibers() << "ns per read" << modm::endl;
+	}
+	return 0;
+}
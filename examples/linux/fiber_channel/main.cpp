@@ -0,0 +1,141 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/debug.hpp>
+#include <modm/processing.hpp>
+
+// Compares passing messages between a producer and a consumer fiber through a
+// fiber::Channel with a busy-yield loop on a shared buffer. A number of idle
+// fibers are also registered, which either spin on yield() or are parked.
+
+constexpr uint32_t messages = 1'000'000;
+constexpr size_t idle_fibers = 8;
+constexpr size_t buffer_size = 16;
+
+uint32_t switches{0};
+bool done{false};
+
+// ============================================================================
+namespace busy
+{
+
+uint32_t buffer[buffer_size];
+size_t head{0}, count{0};
+
+void
+producer()
+{
+	for (uint32_t ii = 0; ii < messages; ii++)
+	{
+		while (count >= buffer_size) { switches++; modm::fiber::yield(); }
+		buffer[(head + count++) % buffer_size] = ii;
+	}
+}
+
+void
+consumer()
+{
+	for (uint32_t ii = 0; ii < messages; ii++)
+	{
+		while (count == 0) { switches++; modm::fiber::yield(); }
+		modm_assert(buffer[head] == ii, "busy.order", "Messages out of order!");
+		head = (head + 1) % buffer_size;
+		count--;
+	}
+	done = true;
+}
+
+void
+idle()
+{
+	while (not done) { switches++; modm::fiber::yield(); }
+}
+
+}	// namespace busy
+
+// ============================================================================
+namespace channel
+{
+
+modm::fiber::Channel<uint32_t, buffer_size> channel;
+modm::fiber::Waitable finished;
+
+void
+producer()
+{
+	for (uint32_t ii = 0; ii < messages; ii++)
+	{
+		// a full channel parks the producer: one switch away from it
+		if (channel.full()) switches++;
+		channel.send(ii);
+	}
+}
+
+void
+consumer()
+{
+	for (uint32_t ii = 0; ii < messages; ii++)
+	{
+		if (channel.empty()) switches++;
+		const uint32_t message = channel.receive();
+		modm_assert(message == ii, "channel.order", "Messages out of order!");
+	}
+	finished.signalAll();
+}
+
+void
+idle()
+{
+	switches++;
+	finished.wait();
+}
+
+}	// namespace channel
+
+// ============================================================================
+modm::fiber::Stack<2048> stack_producer, stack_consumer;
+modm::fiber::Stack<1024> stack_idle[idle_fibers];
+
+template< class Producer, class Consumer, class Idle >
+void
+benchmark(const char *name, Producer&& producer, Consumer&& consumer, Idle&& idle)
+{
+	switches = 0;
+	done = false;
+	modm::Fiber fiber_producer(stack_producer, producer);
+	modm::Fiber fiber_consumer(stack_consumer, consumer);
+	// Fibers must not be copied, so construct them in place
+	alignas(modm::Fiber) uint8_t storage[idle_fibers][sizeof(modm::Fiber)];
+	for (size_t ii = 0; ii < idle_fibers; ii++)
+		new (storage[ii]) modm::Fiber(stack_idle[ii], idle);
+
+	const auto start = modm::PreciseClock::now();
+	modm::fiber::Scheduler::run();
+	const auto diff = modm::PreciseClock::now() - start;
+	const uint64_t us = std::max<uint64_t>(1, std::chrono::duration_cast<std::chrono::microseconds>(diff).count());
+
+	MODM_LOG_INFO << name << ": " << (uint64_t(messages) * 1'000'000 / us) << " messages/s, ";
+	MODM_LOG_INFO << (us * 1000 / messages) << "ns/message, ";
+	MODM_LOG_INFO << (float(switches) / messages) << " switches/message" << modm::endl;
+}
+
+// Hosted x86_64 (GCC 12, -O2):
+// busy: 88300220 messages/s, 11ns/message, 0.62499 switches/message
+// channel: 127080950 messages/s, 7ns/message, 0.125006 switches/message
+int
+main()
+{
+	MODM_LOG_INFO << "Passing " << messages << " messages through a buffer of "
+				  << buffer_size << " with " << idle_fibers << " idle fibers:" << modm::endl;
+
+	benchmark("busy", busy::producer, busy::consumer, busy::idle);
+	benchmark("channel", channel::producer, channel::consumer, channel::idle);
+
+	return 0;
+}
@@ -0,0 +1,83 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/debug.hpp>
+#include <modm/processing.hpp>
+
+using namespace std::chrono_literals;
+
+// Runs a few fibers with different workloads and prints a `top`-like table of
+// the stack usage, context switches and run time of every fiber.
+
+bool running{true};
+volatile uint32_t sink;
+
+uint32_t
+recurse(uint32_t depth)
+{
+	volatile uint8_t buffer[64];
+	buffer[0] = depth;
+	if (depth == 0) return buffer[0];
+	return recurse(depth - 1) + buffer[0];
+}
+
+// Calling into the C library on hosted requires larger stacks
+modm::fiber::Stack<8192> stack_compute, stack_sleep, stack_deep, stack_monitor;
+
+modm::Fiber fiber_compute(stack_compute, []()
+{
+	while (running)
+	{
+		for (uint32_t ii = 0; ii < 10'000; ii++) sink = sink + ii;
+		modm::fiber::yield();
+	}
+});
+
+modm::Fiber fiber_sleep(stack_sleep, []()
+{
+	while (running) modm::fiber::sleep_for(1ms);
+});
+
+modm::Fiber fiber_deep(stack_deep, []()
+{
+	while (running)
+	{
+		sink = recurse(40);
+		modm::fiber::yield();
+	}
+});
+
+modm::Fiber fiber_monitor(stack_monitor, []()
+{
+	modm::fiber::sleep_for(1s);
+	running = false;
+
+	MODM_LOG_INFO << "fiber           stack   used     jumps   time" << modm::endl;
+	for (const modm::Fiber& fiber : modm::fiber::Scheduler::fibers())
+	{
+		const char* name = "?";
+		if (&fiber == &fiber_compute) name = "compute";
+		else if (&fiber == &fiber_sleep) name = "sleep";
+		else if (&fiber == &fiber_deep) name = "deep";
+		else if (&fiber == &fiber_monitor) name = "monitor";
+		MODM_LOG_INFO.printf("%-12s %8zu %6zu %9lu %6lums\n", name,
+				fiber.stackSize(), fiber.stackUsage(), (unsigned long) fiber.jumpCount(),
+				(unsigned long) std::chrono::duration_cast<std::chrono::milliseconds>(fiber.runTime()).count());
+	}
+	MODM_LOG_INFO.printf("%-12s %33lums\n", "idle",
+			(unsigned long) std::chrono::duration_cast<std::chrono::milliseconds>(
+				modm::fiber::Scheduler::idleTime()).count());
+});
+
+int
+main()
+{
+	modm::fiber::Scheduler::run();
+	return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/debug.hpp>
+#include <modm/processing.hpp>
+
+using namespace std::chrono_literals;
+
+// Measures how late a periodic control fiber wakes up from sleep_for() while
+// 50 low priority fibers compete for the CPU, once with the same priority as
+// the low priority fibers and once with a higher priority.
+
+constexpr size_t low_fibers = 50;
+constexpr uint32_t periods = 1000;
+constexpr auto period = 1ms;
+
+bool running{true};
+volatile uint32_t sink;
+
+void
+low()
+{
+	while (running)
+	{
+		for (uint32_t ii = 0; ii < 1000; ii++) sink = sink + ii;
+		modm::fiber::yield();
+	}
+}
+
+uint32_t worst_latency;
+uint64_t total_latency;
+
+void
+control()
+{
+	for (uint32_t ii = 0; ii < periods; ii++)
+	{
+		const auto deadline = modm::PreciseClock::now() + period;
+		modm::fiber::sleep_until(deadline);
+		const uint32_t latency = (modm::PreciseClock::now() - deadline).count();
+		worst_latency = std::max(worst_latency, latency);
+		total_latency += latency;
+	}
+	running = false;
+}
+
+// Calling into the C library on hosted requires larger stacks
+modm::fiber::Stack<8192> stack_low[low_fibers];
+modm::fiber::Stack<8192> stack_control;
+
+void
+benchmark(const char *name, uint8_t priority)
+{
+	running = true;
+	worst_latency = 0;
+	total_latency = 0;
+	// Fibers must not be copied, so construct them in place
+	alignas(modm::Fiber) uint8_t storage[low_fibers][sizeof(modm::Fiber)];
+	for (size_t ii = 0; ii < low_fibers; ii++)
+		new (storage[ii]) modm::Fiber(stack_low[ii], low, 0);
+	modm::Fiber fiber_control(stack_control, control, priority);
+
+	modm::fiber::Scheduler::run();
+
+	MODM_LOG_INFO << name << ": worst latency " << worst_latency << "us, average latency "
+				  << uint32_t(total_latency / periods) << "us" << modm::endl;
+}
+
+// Hosted x86_64 (GCC 12, -O2), the worst case is dominated by the OS
+// preempting the process on a busy machine:
+// same priority: worst latency 3551us, average latency 162us
+// high priority: worst latency 2636us, average latency 12us
+int
+main()
+{
+	MODM_LOG_INFO << "Control fiber waking up every " << period << " with "
+				  << low_fibers << " low priority fibers:" << modm::endl;
+
+	benchmark("same priority", 0);
+	benchmark("high priority", 1);
+
+	return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/debug.hpp>
+#include <modm/processing.hpp>
+#include <ctime>
+#include <fcntl.h>
+
+using namespace std::chrono_literals;
+
+// A producer fiber sleeps and then writes a timestamp into a pipe, which the
+// consumer fiber reads with modm::fiber::read(). While both fibers wait, the
+// scheduler blocks in epoll_wait() with the deadline of the producer as the
+// timeout, so the process uses almost no CPU time.
+
+constexpr uint32_t messages = 200;
+constexpr auto period = 5ms;
+
+int fds[2];
+uint32_t worst_latency;
+uint64_t total_latency;
+
+void
+producer()
+{
+	for (uint32_t ii = 0; ii < messages; ii++)
+	{
+		modm::fiber::sleep_for(period);
+		const uint32_t now = modm::PreciseClock::now().time_since_epoch().count();
+		modm::fiber::write(fds[1], &now, sizeof(now));
+	}
+	::close(fds[1]);
+}
+
+void
+consumer()
+{
+	uint32_t sent;
+	while (modm::fiber::read(fds[0], &sent, sizeof(sent)) == sizeof(sent))
+	{
+		const uint32_t latency = modm::PreciseClock::now().time_since_epoch().count() - sent;
+		worst_latency = std::max(worst_latency, latency);
+		total_latency += latency;
+	}
+}
+
+// Calling into the C library on hosted requires larger stacks
+modm::fiber::Stack<8192> stack_producer, stack_consumer;
+modm::Fiber fiber_producer(stack_producer, producer);
+modm::Fiber fiber_consumer(stack_consumer, consumer);
+
+// Hosted x86_64 (GCC 12, -O2), for comparison a millisecond epoll_wait()
+// timeout with busy-waiting for the remainder used 160ms of CPU time:
+// 200 messages in 1040ms using 7ms of CPU time
+// worst latency 100us, average latency 10us
+int
+main()
+{
+	pipe2(fds, O_NONBLOCK);
+
+	const auto start = modm::PreciseClock::now();
+	const auto cpu_start = std::clock();
+	modm::fiber::Scheduler::run();
+	const auto cpu_ms = (std::clock() - cpu_start) * 1000 / CLOCKS_PER_SEC;
+	const auto wall = modm::PreciseClock::now() - start;
+
+	MODM_LOG_INFO << messages << " messages in " << std::chrono::duration_cast<std::chrono::milliseconds>(wall)
+				  << " using " << uint32_t(cpu_ms) << "ms of CPU time" << modm::endl;
+	MODM_LOG_INFO << "worst latency " << worst_latency << "us, average latency "
+				  << uint32_t(total_latency / messages) << "us" << modm::endl;
+	return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/debug.hpp>
+#include <modm/processing.hpp>
+
+using namespace std::chrono_literals;
+
+// Compares many mostly-idle fibers waiting for a periodic deadline by polling a
+// modm::Timeout in a yield loop with suspending the fibers via sleep_for.
+// A single worker fiber runs concurrently and counts how often it is resumed.
+
+constexpr size_t idle_fibers = 32;
+constexpr uint32_t periods = 100;
+constexpr auto period = 10ms;
+
+uint32_t resumes{0};
+uint32_t work{0};
+size_t running{0};
+
+void
+polling()
+{
+	for (uint32_t ii = 0; ii < periods; ii++)
+	{
+		modm::Timeout timeout{period};
+		while (not timeout.isExpired()) { resumes++; modm::fiber::yield(); }
+	}
+	running--;
+}
+
+void
+sleeping()
+{
+	for (uint32_t ii = 0; ii < periods; ii++)
+	{
+		resumes++;
+		modm::fiber::sleep_for(period);
+	}
+	running--;
+}
+
+void
+worker()
+{
+	while (running) { work++; modm::fiber::yield(); }
+}
+
+// Calling into the C library on hosted requires larger stacks
+modm::fiber::Stack<8192> stack_worker;
+modm::fiber::Stack<8192> stack_idle[idle_fibers];
+
+void
+benchmark(const char *name, void(*idle)())
+{
+	resumes = 0;
+	work = 0;
+	running = idle_fibers;
+	// Fibers must not be copied, so construct them in place
+	alignas(modm::Fiber) uint8_t storage[idle_fibers][sizeof(modm::Fiber)];
+	for (size_t ii = 0; ii < idle_fibers; ii++)
+		new (storage[ii]) modm::Fiber(stack_idle[ii], idle);
+	modm::Fiber fiber_worker(stack_worker, worker);
+
+	const auto start = modm::PreciseClock::now();
+	modm::fiber::Scheduler::run();
+	const auto diff = modm::PreciseClock::now() - start;
+
+	MODM_LOG_INFO << name << ": " << std::chrono::duration_cast<std::chrono::milliseconds>(diff);
+	MODM_LOG_INFO << ", idle fiber resumes: " << resumes;
+	MODM_LOG_INFO << ", worker resumes: " << work << modm::endl;
+}
+
+// Hosted x86_64 (GCC 12, -O2):
+// polling: 999ms, idle fiber resumes: 19508073, worker resumes: 609628
+// sleeping: 1002ms, idle fiber resumes: 3200, worker resumes: 23638786
+int
+main()
+{
+	MODM_LOG_INFO << idle_fibers << " fibers waiting " << periods << " times for "
+				  << period << " each:" << modm::endl;
+
+	benchmark("polling", polling);
+	benchmark("sleeping", sleeping);
+
+	return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/debug.hpp>
+#include <modm/processing/rtos.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Many producer threads append into one queue, which is emptied by a single
+// consumer thread, like simulated sensors publishing into one controller.
+// The modm::rtos::Queue is compared to a queue protected by a mutex and
+// condition variables, which is how the Queue was implemented before.
+//
+// Every variant prints one line of JSON with the throughput:
+// {"queue":"rtos","producers":4,"mitem_per_s":12.3}
+
+constexpr uint32_t capacity = 1024;
+constexpr uint32_t items = 2'000'000;
+
+class MutexQueue
+{
+public:
+	MutexQueue(uint32_t length) :
+		length(length)
+	{
+	}
+
+	bool
+	append(const uint32_t& item)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		notFull.wait(lock, [this] { return deque.size() < length; });
+		deque.push_back(item);
+		notEmpty.notify_one();
+		return true;
+	}
+
+	bool
+	get(uint32_t& item)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		notEmpty.wait(lock, [this] { return not deque.empty(); });
+		item = deque.front();
+		deque.pop_front();
+		notFull.notify_one();
+		return true;
+	}
+
+private:
+	std::mutex mutex;
+	std::condition_variable notEmpty;
+	std::condition_variable notFull;
+	std::deque<uint32_t> deque;
+	const uint32_t length;
+};
+
+template< class Queue >
+void
+measure(const char* name, uint32_t producers)
+{
+	Queue queue(capacity);
+	const auto start = std::chrono::steady_clock::now();
+
+	std::vector<std::thread> threads;
+	for (uint32_t ii = 0; ii < producers; ii++)
+	{
+		threads.emplace_back([&queue, ii, producers]
+		{
+			// distribute the items evenly among the producers
+			for (uint32_t item = ii; item < items; item += producers)
+				queue.append(item);
+		});
+	}
+	uint64_t checksum{0};
+	for (uint32_t received = 0; received < items; received++)
+	{
+		uint32_t item;
+		queue.get(item);
+		checksum += item;
+	}
+	for (auto& thread : threads) thread.join();
+	const auto diff = std::chrono::steady_clock::now() - start;
+
+	const double seconds = std::chrono::duration<double>(diff).count();
+	MODM_LOG_INFO.printf("{\"queue\":\"%s\",\"producers\":%u,\"mitem_per_s\":%.2f,\"checksum\":%llu}\n",
+						 name, producers, items / seconds / 1e6, (unsigned long long) checksum);
+}
+
+int
+main()
+{
+	for (const uint32_t producers : {1, 2, 4, 8, 16})
+	{
+		measure<MutexQueue>("mutex", producers);
+		measure< modm::rtos::Queue<uint32_t> >("rtos", producers);
+	}
+	return 0;
+}
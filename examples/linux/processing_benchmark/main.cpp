@@ -0,0 +1,425 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/debug.hpp>
+#include <modm/processing.hpp>
+#include <modm/processing/fiber.hpp>
+#include <modm/processing/protothread.hpp>
+#include <modm/processing/resumable.hpp>
+#include <modm/processing/rtos.hpp>
+#include <modm/processing/scheduler/scheduler.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <pthread.h>
+#include <thread>
+
+// Compares the processing models of modm on the same two workloads:
+//
+// - pingpong: two tasks pass a token back and forth, every handover requires
+//   a switch to the other task. Reported in nanoseconds per handover.
+// - yield: a number of tasks yield repeatedly without doing any work.
+//   Reported in nanoseconds per yield.
+//
+// The RAM of a single task is split into the size of the task object, the
+// heap allocated by the model and the stack of the task, if it has its own.
+//
+// Every model prints one line of JSON, so that the results can be collected
+// by a script and compared over releases:
+// {"model":"fiber","pingpong_ns":12.3,"yield_ns":10.1,"task_bytes":48,"heap_bytes":0,"stack_bytes":1024}
+
+constexpr uint32_t rounds = 1'000'000;
+constexpr size_t tasks = 16;
+constexpr uint32_t yields = 100'000;
+
+// Counts the heap used by a model, modm::Scheduler allocates its task list
+std::atomic<size_t> allocated{0};
+
+void*
+operator new(size_t size)
+{
+	allocated += size;
+	return std::malloc(size);
+}
+
+void
+operator delete(void* ptr) noexcept
+{ std::free(ptr); }
+
+void
+operator delete(void* ptr, size_t) noexcept
+{ std::free(ptr); }
+
+// ----------------------------------------------------------------------------
+struct Result
+{
+	const char* model;
+	double pingpong_ns;
+	double yield_ns;
+	size_t task_bytes;
+	size_t heap_bytes;
+	size_t stack_bytes;
+};
+
+void
+report(const Result& result)
+{
+	MODM_LOG_INFO.printf("{\"model\":\"%s\",\"pingpong_ns\":%.1f,\"yield_ns\":%.1f,"
+						 "\"task_bytes\":%zu,\"heap_bytes\":%zu,\"stack_bytes\":%zu}\n",
+						 result.model, result.pingpong_ns, result.yield_ns,
+						 result.task_bytes, result.heap_bytes, result.stack_bytes);
+}
+
+template< class Function >
+double
+measure(uint32_t count, Function&& function)
+{
+	const auto start = std::chrono::steady_clock::now();
+	function();
+	const auto diff = std::chrono::steady_clock::now() - start;
+	return double(std::chrono::duration_cast<std::chrono::nanoseconds>(diff).count()) / count;
+}
+
+volatile uint8_t token;
+
+// ----------------------------------------------------------------------------
+namespace protothread
+{
+
+class PingPong : public modm::pt::Protothread
+{
+public:
+	uint8_t id;
+	uint32_t count;
+
+	bool
+	run()
+	{
+		PT_BEGIN();
+		for (count = 0; count < rounds; count++)
+		{
+			PT_WAIT_UNTIL(token == id);
+			token = !id;
+		}
+		PT_END();
+	}
+};
+
+class Yield : public modm::pt::Protothread
+{
+public:
+	uint32_t count;
+
+	bool
+	run()
+	{
+		PT_BEGIN();
+		for (count = 0; count < yields; count++)
+			PT_YIELD();
+		PT_END();
+	}
+};
+
+Result
+benchmark()
+{
+	Result result{"protothread"};
+	result.pingpong_ns = measure(2 * rounds, []
+	{
+		PingPong ping, pong;
+		ping.id = 0; pong.id = 1; token = 0;
+		while (ping.run() | pong.run()) ;
+	});
+	result.yield_ns = measure(tasks * yields, []
+	{
+		Yield threads[tasks];
+		bool running{true};
+		while (running)
+		{
+			running = false;
+			for (auto& thread : threads) running |= thread.run();
+		}
+	});
+	result.task_bytes = sizeof(modm::pt::Protothread);
+	return result;
+}
+
+}	// namespace protothread
+
+// ----------------------------------------------------------------------------
+namespace resumable
+{
+
+class PingPong : public modm::Resumable<1>
+{
+public:
+	uint8_t id;
+	uint32_t count;
+
+	modm::ResumableResult<void>
+	run()
+	{
+		RF_BEGIN(0);
+		for (count = 0; count < rounds; count++)
+		{
+			RF_WAIT_UNTIL(token == id);
+			token = !id;
+		}
+		RF_END();
+	}
+};
+
+class Yield : public modm::Resumable<1>
+{
+public:
+	uint32_t count;
+
+	modm::ResumableResult<void>
+	run()
+	{
+		RF_BEGIN(0);
+		for (count = 0; count < yields; count++)
+			RF_YIELD();
+		RF_END();
+	}
+};
+
+Result
+benchmark()
+{
+	Result result{"resumable"};
+	result.pingpong_ns = measure(2 * rounds, []
+	{
+		PingPong ping, pong;
+		ping.id = 0; pong.id = 1; token = 0;
+		while ((ping.run().getState() == modm::rf::Running) |
+			   (pong.run().getState() == modm::rf::Running)) ;
+	});
+	result.yield_ns = measure(tasks * yields, []
+	{
+		Yield functions[tasks];
+		bool running{true};
+		while (running)
+		{
+			running = false;
+			for (auto& function : functions)
+				running |= function.run().getState() == modm::rf::Running;
+		}
+	});
+	result.task_bytes = sizeof(modm::Resumable<1>);
+	return result;
+}
+
+}	// namespace resumable
+
+// ----------------------------------------------------------------------------
+namespace fiber
+{
+
+constexpr size_t stack_size = 1024;
+modm::fiber::Stack<stack_size> stacks[tasks];
+
+void
+pingpong(uint8_t id)
+{
+	for (uint32_t count = 0; count < rounds; count++)
+	{
+		while (token != id) modm::fiber::yield();
+		token = !id;
+	}
+}
+
+void
+yield()
+{
+	for (uint32_t count = 0; count < yields; count++)
+		modm::fiber::yield();
+}
+
+Result
+benchmark()
+{
+	Result result{"fiber"};
+	// Fibers must not be copied, so construct them in place
+	alignas(modm::Fiber) uint8_t storage[tasks][sizeof(modm::Fiber)];
+
+	token = 0;
+	new (storage[0]) modm::Fiber(stacks[0], []{ pingpong(0); });
+	new (storage[1]) modm::Fiber(stacks[1], []{ pingpong(1); });
+	result.pingpong_ns = measure(2 * rounds, [] { modm::fiber::Scheduler::run(); });
+
+	for (size_t ii = 0; ii < tasks; ii++)
+		new (storage[ii]) modm::Fiber(stacks[ii], yield);
+	result.yield_ns = measure(tasks * yields, [] { modm::fiber::Scheduler::run(); });
+
+	result.task_bytes = sizeof(modm::Fiber);
+	result.stack_bytes = stack_size;
+	return result;
+}
+
+}	// namespace fiber
+
+// ----------------------------------------------------------------------------
+namespace scheduler
+{
+
+// Tasks of modm::Scheduler run to completion, so every call of run() is one
+// switch. A task period of one tick makes all tasks ready on every tick.
+class PingPong : public modm::Scheduler::Task
+{
+public:
+	uint8_t id{0};
+
+	void
+	run() override
+	{
+		if (token == id) token = !id;
+	}
+};
+
+class Yield : public modm::Scheduler::Task
+{
+public:
+	void
+	run() override {}
+};
+
+Result
+benchmark()
+{
+	Result result{"scheduler"};
+	result.pingpong_ns = measure(2 * rounds, []
+	{
+		modm::Scheduler scheduler;
+		PingPong ping, pong;
+		pong.id = 1; token = 0;
+		scheduler.scheduleTask(ping, 1);
+		scheduler.scheduleTask(pong, 1);
+		for (uint32_t count = 0; count < rounds; count++)
+			scheduler.schedule();
+	});
+
+	const size_t before = allocated;
+	modm::Scheduler scheduler;
+	Yield threads[tasks];
+	for (auto& thread : threads)
+		scheduler.scheduleTask(thread, 1);
+	result.heap_bytes = (allocated - before) / tasks;
+	result.yield_ns = measure(tasks * yields, [&]
+	{
+		for (uint32_t count = 0; count < yields; count++)
+			scheduler.schedule();
+	});
+	result.task_bytes = sizeof(modm::Scheduler::Task);
+	return result;
+}
+
+}	// namespace scheduler
+
+// ----------------------------------------------------------------------------
+namespace rtos
+{
+
+// The stdlib threads run in parallel on all CPUs, so the handover includes
+// the wake-up latency of the operating system.
+modm::rtos::BinarySemaphore ping_event, pong_event;
+modm::rtos::Semaphore pingpong_done(2, 0);
+modm::rtos::Semaphore yield_start(tasks, 0);
+modm::rtos::Semaphore yield_done(tasks, 0);
+
+class PingPong : public modm::rtos::Thread
+{
+public:
+	PingPong(modm::rtos::BinarySemaphore& wait, modm::rtos::BinarySemaphore& signal) :
+		wait(wait), signal(signal) {}
+
+	void
+	run() override
+	{
+		for (uint32_t count = 0; count < rounds; count++)
+		{
+			wait.acquire();
+			signal.release();
+		}
+		pingpong_done.release();
+		// Threads must never return
+		while (true) sleep(1000 * MILLISECONDS);
+	}
+
+private:
+	modm::rtos::BinarySemaphore& wait;
+	modm::rtos::BinarySemaphore& signal;
+};
+
+class Yield : public modm::rtos::Thread
+{
+public:
+	void
+	run() override
+	{
+		yield_start.acquire();
+		for (uint32_t count = 0; count < yields; count++)
+			yield();
+		yield_done.release();
+		while (true) sleep(1000 * MILLISECONDS);
+	}
+};
+
+Result
+benchmark()
+{
+	Result result{"rtos"};
+	// Binary semaphores are released by default
+	ping_event.acquire();
+	pong_event.acquire();
+
+	// Threads are only started by the never returning scheduler, so they are
+	// created up front and never destroyed.
+	new PingPong(ping_event, pong_event);
+	new PingPong(pong_event, ping_event);
+	for (size_t ii = 0; ii < tasks; ii++) new Yield();
+	std::thread(modm::rtos::Scheduler::schedule).detach();
+
+	result.pingpong_ns = measure(2 * rounds, []
+	{
+		ping_event.release();
+		pingpong_done.acquire();
+		pingpong_done.acquire();
+	});
+	result.yield_ns = measure(tasks * yields, []
+	{
+		for (size_t ii = 0; ii < tasks; ii++) yield_start.release();
+		for (size_t ii = 0; ii < tasks; ii++) yield_done.acquire();
+	});
+
+	result.task_bytes = sizeof(modm::rtos::Thread);
+	pthread_attr_t attr;
+	size_t stack_size{0};
+	pthread_attr_init(&attr);
+	pthread_attr_getstacksize(&attr, &stack_size);
+	pthread_attr_destroy(&attr);
+	result.stack_bytes = stack_size;
+	return result;
+}
+
+}	// namespace rtos
+
+// ----------------------------------------------------------------------------
+int
+main()
+{
+	report(protothread::benchmark());
+	report(resumable::benchmark());
+	report(fiber::benchmark());
+	report(scheduler::benchmark());
+	report(rtos::benchmark());
+	return 0;
+}
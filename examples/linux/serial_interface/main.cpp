@@ -32,7 +32,9 @@ main()
 	while(true)
 	{
 		uint8_t a;
-		port.readBytes(&a, 1);
+		if (port.readBytes(&a, 1) != 1) {
+			break;
+		}
 		MODM_LOG_DEBUG << "Read: " << a << modm::endl;
 
 		/*char a;
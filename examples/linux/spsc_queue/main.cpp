@@ -0,0 +1,120 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/debug.hpp>
+#include <modm/architecture/driver/atomic/queue.hpp>
+#include <modm/architecture/driver/atomic/spsc_queue.hpp>
+
+#include <chrono>
+#include <thread>
+
+// Passes bytes from a producer thread to a consumer thread through the
+// modm::atomic::Queue one byte at a time and through the SpscQueue one byte at
+// a time and in chunks. Both threads yield if the queue is full or empty, so
+// that the benchmark also works on a single CPU.
+//
+// Every variant prints one line of JSON with the throughput:
+// {"queue":"spsc_bulk","chunk":64,"mbyte_per_s":1234.5}
+
+constexpr size_t bytes = 32'000'000;
+
+template< class Producer, class Consumer >
+void
+measure(const char* name, size_t chunk, Producer&& producer, Consumer&& consumer)
+{
+	const auto start = std::chrono::steady_clock::now();
+	std::thread thread([&]
+	{
+		for (size_t sent = 0; sent < bytes; )
+		{
+			const size_t count = producer(sent);
+			if (count == 0) std::this_thread::yield();
+			sent += count;
+		}
+	});
+	uint32_t checksum{0};
+	for (size_t received = 0; received < bytes; )
+	{
+		const size_t count = consumer(checksum);
+		if (count == 0) std::this_thread::yield();
+		received += count;
+	}
+	thread.join();
+	const auto diff = std::chrono::steady_clock::now() - start;
+
+	const double seconds = std::chrono::duration<double>(diff).count();
+	MODM_LOG_INFO.printf("{\"queue\":\"%s\",\"chunk\":%zu,\"mbyte_per_s\":%.1f,\"checksum\":%u}\n",
+						 name, chunk, bytes / seconds / 1e6, checksum);
+}
+
+// The queue only uses volatile indices without memory ordering, which is
+// sufficient on x86, but not on CPUs with weak memory ordering.
+modm::atomic::Queue<uint8_t, 255> queue;
+modm::atomic::SpscQueue<uint8_t, 256> spsc;
+
+int
+main()
+{
+	measure("queue", 1,
+		[](size_t sent) -> size_t { return queue.push(uint8_t(sent)); },
+		[](uint32_t& sum) -> size_t
+		{
+			if (queue.isEmpty()) return 0;
+			sum += queue.get();
+			queue.pop();
+			return 1;
+		});
+
+	measure("spsc", 1,
+		[](size_t sent) -> size_t { return spsc.push(uint8_t(sent)); },
+		[](uint32_t& sum) -> size_t
+		{
+			uint8_t value;
+			if (not spsc.pop(value)) return 0;
+			sum += value;
+			return 1;
+		});
+
+	for (const size_t chunk : {16, 64, 256})
+	{
+		measure("spsc_bulk", chunk,
+			[chunk](size_t sent) -> size_t
+			{
+				uint8_t data[256];
+				for (size_t ii = 0; ii < chunk; ii++) data[ii] = uint8_t(sent + ii);
+				return spsc.push(std::span{data, std::min(chunk, bytes - sent)});
+			},
+			[chunk](uint32_t& sum) -> size_t
+			{
+				uint8_t data[256];
+				const size_t count = spsc.pop(std::span{data, chunk});
+				for (size_t ii = 0; ii < count; ii++) sum += data[ii];
+				return count;
+			});
+	}
+
+	// the producer writes directly into the buffer without an extra copy
+	measure("spsc_span", 0,
+		[](size_t sent) -> size_t
+		{
+			auto region = spsc.pushSpan();
+			const size_t count = std::min(region.size(), bytes - sent);
+			for (size_t ii = 0; ii < count; ii++) region[ii] = uint8_t(sent + ii);
+			spsc.commitPush(count);
+			return count;
+		},
+		[](uint32_t& sum) -> size_t
+		{
+			auto region = spsc.popSpan();
+			for (const uint8_t value : region) sum += value;
+			spsc.commitPop(region.size());
+			return region.size();
+		});
+	return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/debug.hpp>
+#include <modm/processing/timer.hpp>
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+// Compares 10000 polled periodic timers with the same timers on a timer wheel.
+// Both run for the same time with periods between 10ms and 1s, and report the
+// average cost of one pass of the main loop and the number of expirations.
+// The wheel additionally reports the cost of restarting and stopping a timer.
+//
+// Every variant prints one line of JSON:
+// {"timers":"wheel","loop_ns":12.3,"expired":12345,"start_ns":4.5,"stop_ns":1.2}
+
+constexpr size_t count = 10'000;
+constexpr auto runtime = 2s;
+
+std::chrono::milliseconds
+period(size_t index)
+{
+	return std::chrono::milliseconds(10 + (index * 7919) % 1000);
+}
+
+template< class Function >
+double
+measure(Function&& function)
+{
+	const auto start = std::chrono::steady_clock::now();
+	const uint32_t loops = function();
+	const auto diff = std::chrono::steady_clock::now() - start;
+	return double(std::chrono::duration_cast<std::chrono::nanoseconds>(diff).count()) / loops;
+}
+
+modm::PeriodicTimer polled[count];
+modm::TimerWheel::Timer timers[count];
+size_t expired{0};
+
+void
+benchmarkPolled()
+{
+	for (size_t ii = 0; ii < count; ii++) polled[ii].restart(period(ii));
+	expired = 0;
+
+	const double loop_ns = measure([]
+	{
+		uint32_t loops{0};
+		const modm::Timeout timeout{runtime};
+		for (; not timeout.isExpired(); loops++)
+		{
+			for (auto& timer : polled) expired += timer.execute();
+		}
+		return loops;
+	});
+
+	MODM_LOG_INFO.printf("{\"timers\":\"polled\",\"loop_ns\":%.1f,\"expired\":%zu}\n",
+						 loop_ns, expired);
+}
+
+void
+benchmarkWheel()
+{
+	modm::TimerWheel wheel;
+	for (size_t ii = 0; ii < count; ii++)
+	{
+		timers[ii].setCallback([] { expired++; });
+		wheel.startPeriodic(timers[ii], period(ii));
+	}
+	expired = 0;
+
+	const double loop_ns = measure([&]
+	{
+		uint32_t loops{0};
+		const modm::Timeout timeout{runtime};
+		for (; not timeout.isExpired(); loops++) wheel.update();
+		return loops;
+	});
+
+	const double start_ns = measure([&]
+	{
+		for (uint32_t round = 0; round < 100; round++)
+		{
+			for (size_t ii = 0; ii < count; ii++) wheel.start(timers[ii], period(ii + round));
+		}
+		return 100 * count;
+	});
+	const double stop_ns = measure([&]
+	{
+		for (auto& timer : timers) wheel.stop(timer);
+		return count;
+	});
+
+	MODM_LOG_INFO.printf("{\"timers\":\"wheel\",\"loop_ns\":%.1f,\"expired\":%zu,"
+						 "\"start_ns\":%.1f,\"stop_ns\":%.1f}\n",
+						 loop_ns, expired, start_ns, stop_ns);
+}
+
+int
+main()
+{
+	benchmarkPolled();
+	benchmarkWheel();
+	return 0;
+}
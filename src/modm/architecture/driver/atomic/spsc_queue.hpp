@@ -0,0 +1,161 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <modm/architecture/detect.hpp>
+#include <modm/architecture/utils.hpp>
+
+namespace modm::atomic
+{
+
+/**
+ * Lock-free single-producer single-consumer ring buffer.
+ *
+ * One context, for example an interrupt, pushes into the queue and another
+ * context, for example the main loop, pops from it without any locks. The
+ * head and tail indices run freely and are masked with the power-of-two size,
+ * so that all N elements of the buffer can be used. The indices are published
+ * with release and read with acquire ordering, so the queue is also safe
+ * between threads and CPU cores with weak memory ordering.
+ *
+ * Besides single elements, spans of elements can be pushed and popped at once.
+ * For DMA transfers or `memcpy()`, `pushSpan()` and `popSpan()` return the
+ * largest contiguous region of the buffer that can be written or read
+ * directly, which is then committed with `commitPush()` or `commitPop()`.
+ *
+ * ```cpp
+ * modm::atomic::SpscQueue<uint8_t, 256> queue;
+ *
+ * // producer: let the DMA fill the free region
+ * auto region = queue.pushSpan();
+ * size_t received = Dma::receive(region.data(), region.size());
+ * queue.commitPush(received);
+ *
+ * // consumer
+ * uint8_t buffer[64];
+ * size_t count = queue.pop(buffer);
+ * ```
+ *
+ * Only the producer may call the push functions and only the consumer may call
+ * the get and pop functions. On hosted targets the indices are placed into
+ * separate cache lines to avoid false sharing between the two threads.
+ *
+ * @tparam	T	trivially copyable element type.
+ * @tparam	N	number of elements, must be a power of two.
+ *
+ * @ingroup	modm_architecture_atomic
+ */
+template< typename T, std::size_t N >
+class SpscQueue
+{
+	static_assert(N > 0 and (N & (N - 1)) == 0, "The size must be a power of two!");
+	static_assert(std::is_trivially_copyable_v<T>, "The elements must be trivially copyable!");
+
+public:
+	/// The free running indices must wrap at a multiple of twice the size.
+	using Index = std::conditional_t< (N <= 128), uint8_t,
+				  std::conditional_t< (N <= 32768), uint16_t, uint32_t > >;
+	using Size = Index;
+
+public:
+	SpscQueue() = default;
+
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	bool
+	isFull() const;
+
+	bool
+	isNotFull() const { return not isFull(); }
+
+	bool
+	isEmpty() const;
+
+	bool
+	isNotEmpty() const { return not isEmpty(); }
+
+	static constexpr Size
+	getMaxSize() { return N; }
+
+	/// @return the number of stored elements.
+	Size
+	getSize() const;
+
+	// Producer ---------------------------------------------------------------
+	/// @return `false` if the queue is full.
+	bool
+	push(const T& value);
+
+	/// Copies as many values as fit into the queue.
+	/// @return the number of values pushed.
+	std::size_t
+	push(std::span<const T> values);
+
+	/// @return the largest contiguous region of free elements, which may be
+	///         smaller than the free space, if the free space wraps around.
+	std::span<T>
+	pushSpan();
+
+	/// Publishes the first `count` elements of the region returned by `pushSpan()`.
+	void
+	commitPush(std::size_t count);
+
+	// Consumer ---------------------------------------------------------------
+	/// @return the oldest element. The queue must not be empty.
+	const T&
+	get() const;
+
+	/// Removes the oldest element. The queue must not be empty.
+	void
+	pop();
+
+	/// Removes the oldest element and copies it into `value`.
+	/// @return `false` if the queue is empty.
+	bool
+	pop(T& value);
+
+	/// Copies as many values as stored out of the queue.
+	/// @return the number of values popped.
+	std::size_t
+	pop(std::span<T> values);
+
+	/// @return the largest contiguous region of stored elements, which may be
+	///         smaller than the number of stored elements, if they wrap around.
+	std::span<const T>
+	popSpan() const;
+
+	/// Removes the first `count` elements of the region returned by `popSpan()`.
+	void
+	commitPop(std::size_t count);
+
+private:
+	static constexpr Index Mask = N - 1;
+#ifdef MODM_OS_HOSTED
+	static constexpr std::size_t Alignment = 64;
+#else
+	static constexpr std::size_t Alignment = alignof(std::atomic<Index>);
+#endif
+
+	/// Written by the producer
+	alignas(Alignment) std::atomic<Index> head{0};
+	/// Written by the consumer
+	alignas(Alignment) std::atomic<Index> tail{0};
+	alignas(Alignment) T buffer[N];
+};
+
+}	// namespace modm::atomic
+
+#include "spsc_queue_impl.hpp"
@@ -0,0 +1,136 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+
+template< typename T, std::size_t N >
+bool
+modm::atomic::SpscQueue<T, N>::isFull() const
+{
+	return getSize() == N;
+}
+
+template< typename T, std::size_t N >
+bool
+modm::atomic::SpscQueue<T, N>::isEmpty() const
+{
+	return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+}
+
+template< typename T, std::size_t N >
+typename modm::atomic::SpscQueue<T, N>::Size
+modm::atomic::SpscQueue<T, N>::getSize() const
+{
+	// read the tail first, so that the size never exceeds N
+	const Index t = tail.load(std::memory_order_acquire);
+	return Index(head.load(std::memory_order_acquire) - t);
+}
+
+// ----------------------------------------------------------------------------
+template< typename T, std::size_t N >
+bool
+modm::atomic::SpscQueue<T, N>::push(const T& value)
+{
+	const Index h = head.load(std::memory_order_relaxed);
+	if (Index(h - tail.load(std::memory_order_acquire)) == N) return false;
+	buffer[h & Mask] = value;
+	head.store(Index(h + 1), std::memory_order_release);
+	return true;
+}
+
+template< typename T, std::size_t N >
+std::size_t
+modm::atomic::SpscQueue<T, N>::push(std::span<const T> values)
+{
+	const Index h = head.load(std::memory_order_relaxed);
+	const Index free = N - Index(h - tail.load(std::memory_order_acquire));
+	const std::size_t count = std::min<std::size_t>(values.size(), free);
+	// copy in at most two parts around the end of the buffer
+	const std::size_t first = std::min<std::size_t>(count, N - (h & Mask));
+	std::copy_n(values.begin(), first, buffer + (h & Mask));
+	std::copy_n(values.begin() + first, count - first, buffer);
+	head.store(Index(h + count), std::memory_order_release);
+	return count;
+}
+
+template< typename T, std::size_t N >
+std::span<T>
+modm::atomic::SpscQueue<T, N>::pushSpan()
+{
+	const Index h = head.load(std::memory_order_relaxed);
+	const Index free = N - Index(h - tail.load(std::memory_order_acquire));
+	return {buffer + (h & Mask), std::min<std::size_t>(free, N - (h & Mask))};
+}
+
+template< typename T, std::size_t N >
+void
+modm::atomic::SpscQueue<T, N>::commitPush(std::size_t count)
+{
+	const Index h = head.load(std::memory_order_relaxed);
+	head.store(Index(h + count), std::memory_order_release);
+}
+
+// ----------------------------------------------------------------------------
+template< typename T, std::size_t N >
+const T&
+modm::atomic::SpscQueue<T, N>::get() const
+{
+	return buffer[tail.load(std::memory_order_relaxed) & Mask];
+}
+
+template< typename T, std::size_t N >
+void
+modm::atomic::SpscQueue<T, N>::pop()
+{
+	const Index t = tail.load(std::memory_order_relaxed);
+	tail.store(Index(t + 1), std::memory_order_release);
+}
+
+template< typename T, std::size_t N >
+bool
+modm::atomic::SpscQueue<T, N>::pop(T& value)
+{
+	const Index t = tail.load(std::memory_order_relaxed);
+	if (head.load(std::memory_order_acquire) == t) return false;
+	value = buffer[t & Mask];
+	tail.store(Index(t + 1), std::memory_order_release);
+	return true;
+}
+
+template< typename T, std::size_t N >
+std::size_t
+modm::atomic::SpscQueue<T, N>::pop(std::span<T> values)
+{
+	const Index t = tail.load(std::memory_order_relaxed);
+	const Index stored = Index(head.load(std::memory_order_acquire) - t);
+	const std::size_t count = std::min<std::size_t>(values.size(), stored);
+	// copy out in at most two parts around the end of the buffer
+	const std::size_t first = std::min<std::size_t>(count, N - (t & Mask));
+	std::copy_n(buffer + (t & Mask), first, values.begin());
+	std::copy_n(buffer, count - first, values.begin() + first);
+	tail.store(Index(t + count), std::memory_order_release);
+	return count;
+}
+
+template< typename T, std::size_t N >
+std::span<const T>
+modm::atomic::SpscQueue<T, N>::popSpan() const
+{
+	const Index t = tail.load(std::memory_order_relaxed);
+	const Index stored = Index(head.load(std::memory_order_acquire) - t);
+	return {buffer + (t & Mask), std::min<std::size_t>(stored, N - (t & Mask))};
+}
+
+template< typename T, std::size_t N >
+void
+modm::atomic::SpscQueue<T, N>::commitPop(std::size_t count)
+{
+	const Index t = tail.load(std::memory_order_relaxed);
+	tail.store(Index(t + count), std::memory_order_release);
+}
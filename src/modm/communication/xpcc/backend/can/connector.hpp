@@ -228,8 +228,12 @@ namespace xpcc
 			operator = (const ReceiveListItem& other);
 		};
 
-		typedef modm::LinkedList< SendListItem > SendList;
-		typedef modm::LinkedList< ReceiveListItem > ReceiveList;
+		// The nodes are pooled, so that the lists do not allocate from the
+		// heap once they have grown to their working size.
+		typedef modm::LinkedList< SendListItem,
+				modm::allocator::Block< SendListItem, 8 > > SendList;
+		typedef modm::LinkedList< ReceiveListItem,
+				modm::allocator::Block< ReceiveListItem, 8 > > ReceiveList;
 
 	protected:
 		SendList sendList;
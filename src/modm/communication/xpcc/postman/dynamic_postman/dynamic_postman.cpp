@@ -28,34 +28,28 @@ xpcc::DynamicPostman::deliverPacket(const Header &header, const modm::SmartPoint
 	if (header.destination == 0)
 	{
 		// EVENT
-		EventMap::const_iterator lowerBound(this->eventMap.lower_bound(header.packetIdentifier));
-		EventMap::const_iterator upperBound(this->eventMap.upper_bound(header.packetIdentifier));
-		if (lowerBound != upperBound) {
-			do {
-				lowerBound->second(header, payload);
-				lowerBound++;
-			}
-			while (lowerBound != upperBound);
-			return OK;
-		}
-		return NO_EVENT;
+		bool delivered = false;
+		this->eventMap.forEach(header.packetIdentifier,
+			[&](const EventListener& listener)
+			{
+				listener(header, payload);
+				delivered = true;
+			});
+		return delivered ? OK : NO_EVENT;
 	}
 	else
 	{
 		// REQUEST
-		ActionMap::const_iterator iterDestination(this->actionMap.find(header.destination));
-		if (iterDestination != this->actionMap.end())
+		const ActionHandler* handler(this->actionMap.find(
+				getActionKey(header.destination, header.packetIdentifier)));
+		if (handler != nullptr)
 		{
-			CallbackMap::const_iterator iterCallback(iterDestination->second.find(header.packetIdentifier));
-			if (iterCallback != iterDestination->second.end())
-			{
-				xpcc::ResponseHandle response(header);
-				iterCallback->second(response, payload);
-				return OK;
-			}
-			else {
-				return NO_ACTION;
-			}
+			xpcc::ResponseHandle response(header);
+			(*handler)(response, payload);
+			return OK;
+		}
+		else if (this->components.test(header.destination)) {
+			return NO_ACTION;
 		}
 		else {
 			return NO_COMPONENT;
@@ -67,7 +61,7 @@ xpcc::DynamicPostman::deliverPacket(const Header &header, const modm::SmartPoint
 bool
 xpcc::DynamicPostman::isComponentAvailable(uint8_t component) const
 {
-	return (this->actionMap.find(component) != this->actionMap.end());
+	return this->components.test(component);
 }
 
 // ----------------------------------------------------------------------------
@@ -23,19 +23,18 @@ xpcc::DynamicPostman::registerEventListener(const uint8_t eventId,
 {
 	using namespace std::placeholders;
 
-	eventMap.insert(
-			std::pair<uint8_t, EventListener>(
-					eventId,
-					EventListener(static_cast<EventCallbackSimple>(
-							std::bind(
-									memberFunction,
-									componentObject,
-									_1)
-					))
-			)
+	const bool inserted = eventMap.insert(
+			eventId,
+			EventListener(static_cast<EventCallbackSimple>(
+					std::bind(
+							memberFunction,
+							componentObject,
+							_1)
+			))
 	);
-
-	return true;
+	modm_assert_continue_ignore(inserted, "xpcc.postman.full",
+			"The DynamicPostman has no space for another event listener!", eventId);
+	return inserted;
 }
 
 template< class C, typename P >
@@ -47,19 +46,18 @@ xpcc::DynamicPostman::registerEventListener(const uint8_t eventId,
 	using namespace std::placeholders;
 	typedef void (C::*Function)(const Header&, const uint8_t&);
 
-	eventMap.insert(
-			std::pair<uint8_t, EventListener>(
-					eventId,
-					EventListener(
-							std::bind(
-									reinterpret_cast<Function>(memberFunction),
-									componentObject,
-									_1, _2)
-					)
+	const bool inserted = eventMap.insert(
+			eventId,
+			EventListener(
+					std::bind(
+							reinterpret_cast<Function>(memberFunction),
+							componentObject,
+							_1, _2)
 			)
 	);
-
-	return true;
+	modm_assert_continue_ignore(inserted, "xpcc.postman.full",
+			"The DynamicPostman has no space for another event listener!", eventId);
+	return inserted;
 }
 
 template< class C >
@@ -71,14 +69,20 @@ xpcc::DynamicPostman::registerActionHandler(const uint8_t componentId,
 {
 	using namespace std::placeholders;
 
-	actionMap[componentId][actionId] = ActionHandler(static_cast<ActionCallbackSimple>(
-			std::bind(
-					memberFunction,
-					componentObject,
-					_1)
-	));
-
-	return true;
+	const bool inserted = actionMap.insertOrAssign(
+			getActionKey(componentId, actionId),
+			ActionHandler(static_cast<ActionCallbackSimple>(
+					std::bind(
+							memberFunction,
+							componentObject,
+							_1)
+			)));
+	modm_assert_continue_ignore(inserted, "xpcc.postman.full",
+			"The DynamicPostman has no space for another action handler!", componentId);
+	if (inserted) {
+		components.set(componentId);
+	}
+	return inserted;
 }
 
 template< class C, typename P >
@@ -91,12 +95,18 @@ xpcc::DynamicPostman::registerActionHandler(const uint8_t componentId,
 	using namespace std::placeholders;
 	typedef void (C::*Function)(const ResponseHandle&, const uint8_t&);
 
-	actionMap[componentId][actionId] = ActionHandler(
-			std::bind(
-					reinterpret_cast<Function>(memberFunction),
-					componentObject,
-					_1, _2)
-	);
-
-	return true;
+	const bool inserted = actionMap.insertOrAssign(
+			getActionKey(componentId, actionId),
+			ActionHandler(
+					std::bind(
+							reinterpret_cast<Function>(memberFunction),
+							componentObject,
+							_1, _2)
+			));
+	modm_assert_continue_ignore(inserted, "xpcc.postman.full",
+			"The DynamicPostman has no space for another action handler!", componentId);
+	if (inserted) {
+		components.set(componentId);
+	}
+	return inserted;
 }
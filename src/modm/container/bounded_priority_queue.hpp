@@ -0,0 +1,294 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace modm
+{
+
+/**
+ * Priority queue with a fixed capacity and without memory allocation.
+ *
+ * The items are ordered in a binary heap, so that `push()`, `pop()` and
+ * `update()` take logarithmic time and `getTop()` constant time. The queue can
+ * replace a sorted `modm::LinkedList`, which needs a linear search for every
+ * insertion and allocates a node for every item.
+ *
+ * Like `std::priority_queue` the top item is the largest one according to
+ * `Compare`, use `std::greater<T>` to get the smallest item first:
+ *
+ * ```cpp
+ * modm::BoundedPriorityQueue<Timeout, 16, std::greater<Timeout>> timeouts;
+ * auto handle = timeouts.push(Timeout{now + 10ms, task});
+ * // the task becomes urgent
+ * timeouts.update(handle, Timeout{now + 1ms, task});
+ * while (not timeouts.isEmpty() and timeouts.getTop().time <= now)
+ * {
+ *     timeouts.getTop().task->resume();
+ *     timeouts.pop();
+ * }
+ * ```
+ *
+ * `push()` returns a handle, with which the item can be accessed, changed and
+ * removed while it is in the queue. The item stays at the same place in
+ * memory until it is removed, only its index is moved in the heap. A handle
+ * is invalidated when its item is popped or removed, since its place may be
+ * reused by the next item.
+ *
+ * All member functions only access memory of the queue itself, so it can be
+ * used in interrupts, if the accesses are not interrupted by the main program.
+ * The items must be default constructible.
+ *
+ * @tparam	T		type of the items
+ * @tparam	N		maximum number of items, at most 65534
+ * @tparam	Compare	function object returning `true` if the first item has a
+ * 					lower priority than the second one
+ *
+ * @ingroup	modm_container
+ */
+template< typename T, std::size_t N, typename Compare = std::less<T> >
+class BoundedPriorityQueue
+{
+	static_assert(N > 0, "size = 0 is not allowed");
+	static_assert(N < 65535, "size is limited to 65534 items");
+
+public:
+	using Index = std::conditional_t< (N >= 255), uint16_t, uint8_t >;
+	using Size = Index;
+
+	/// Refers to an item in the queue
+	class Handle
+	{
+		friend class BoundedPriorityQueue;
+
+	public:
+		/// Creates an invalid handle
+		constexpr Handle() = default;
+
+		/// @return `false` if the handle was returned by a push into a full queue.
+		constexpr bool
+		isValid() const
+		{ return slot != N; }
+
+		constexpr bool
+		operator==(const Handle& other) const
+		{ return slot == other.slot; }
+
+	private:
+		constexpr explicit Handle(Index slot) : slot(slot) {}
+
+		Index slot{N};
+	};
+
+public:
+	constexpr
+	BoundedPriorityQueue()
+	{
+		for (std::size_t ii = 0; ii < N; ++ii)
+		{
+			heap[ii] = ii;
+			position[ii] = ii;
+		}
+	}
+
+	constexpr bool
+	isEmpty() const
+	{ return size == 0; }
+
+	constexpr bool
+	isNotEmpty() const
+	{ return size != 0; }
+
+	constexpr bool
+	isFull() const
+	{ return size == N; }
+
+	constexpr bool
+	isNotFull() const
+	{ return size != N; }
+
+	constexpr Size
+	getSize() const
+	{ return size; }
+
+	constexpr Size
+	getMaxSize() const
+	{ return N; }
+
+	/// Removes all items and invalidates all handles.
+	constexpr void
+	clear()
+	{ size = 0; }
+
+	/**
+	 * Inserts a copy of the value.
+	 *
+	 * @return a handle to the item, which is invalid if the queue is full.
+	 */
+	constexpr Handle
+	push(const T& value)
+	{
+		if (isFull()) return Handle{};
+
+		// the heap contains the unused slots after the used ones
+		const Index slot = heap[size];
+		values[slot] = value;
+		siftUp(size++);
+		return Handle{slot};
+	}
+
+	/**
+	 * Returns the item with the highest priority.
+	 *
+	 * @warning	The queue must not be empty!
+	 */
+	constexpr const T&
+	getTop() const
+	{ return values[heap[0]]; }
+
+	/// Returns the handle of the item with the highest priority.
+	constexpr Handle
+	getTopHandle() const
+	{ return Handle{heap[0]}; }
+
+	/**
+	 * Removes the item with the highest priority.
+	 *
+	 * @warning	The queue must not be empty!
+	 */
+	constexpr void
+	pop()
+	{ remove(getTopHandle()); }
+
+	/// @return `true` if the item of the handle is still in the queue.
+	constexpr bool
+	contains(Handle handle) const
+	{ return handle.isValid() and position[handle.slot] < size; }
+
+	/**
+	 * Returns the item of the handle.
+	 *
+	 * @warning	The item must be in the queue!
+	 */
+	constexpr const T&
+	get(Handle handle) const
+	{ return values[handle.slot]; }
+
+	/**
+	 * Replaces the item of the handle and restores the order of the queue.
+	 *
+	 * This is used to change the priority of an item, for example to decrease
+	 * the time of a timeout.
+	 *
+	 * @warning	The item must be in the queue!
+	 */
+	constexpr void
+	update(Handle handle, const T& value)
+	{
+		values[handle.slot] = value;
+		siftDown(siftUp(position[handle.slot]));
+	}
+
+	/**
+	 * Removes the item of the handle.
+	 *
+	 * @return `false` if the item is not in the queue.
+	 */
+	constexpr bool
+	remove(Handle handle)
+	{
+		if (not contains(handle)) return false;
+
+		const Index index = position[handle.slot];
+		swap(index, --size);
+		if (index < size) {
+			siftDown(siftUp(index));
+		}
+		return true;
+	}
+
+protected:
+	static constexpr Index
+	parent(Index index)
+	{ return (index - 1) / 2; }
+
+	/// Compares the items in two slots
+	constexpr bool
+	isLower(Index first, Index second) const
+	{ return Compare{}(values[first], values[second]); }
+
+	constexpr void
+	swap(Index first, Index second)
+	{
+		std::swap(heap[first], heap[second]);
+		position[heap[first]] = first;
+		position[heap[second]] = second;
+	}
+
+	constexpr void
+	place(Index index, Index slot)
+	{
+		heap[index] = slot;
+		position[slot] = index;
+	}
+
+	/// @return the new index of the item
+	constexpr Index
+	siftUp(Index index)
+	{
+		// move the parents down until the place of the item is found
+		const Index slot = heap[index];
+		while (index > 0 and isLower(heap[parent(index)], slot))
+		{
+			place(index, heap[parent(index)]);
+			index = parent(index);
+		}
+		place(index, slot);
+		return index;
+	}
+
+	constexpr void
+	siftDown(Index index)
+	{
+		// move the larger child up until the place of the item is found
+		const Index slot = heap[index];
+		while (true)
+		{
+			const std::size_t left = 2 * std::size_t(index) + 1;
+			if (left >= size) break;
+
+			Index child = left;
+			if (left + 1 < size and isLower(heap[left], heap[left + 1])) {
+				child = left + 1;
+			}
+			if (not isLower(slot, heap[child])) break;
+
+			place(index, heap[child]);
+			index = child;
+		}
+		place(index, slot);
+	}
+
+	/// The items are stored in slots, which do not move
+	std::array<T, N> values{};
+	/// Binary heap of slots, followed by the unused slots
+	std::array<Index, N> heap{};
+	/// Index of every slot in the heap
+	std::array<Index, N> position{};
+	Size size{0};
+};
+
+}	// namespace modm
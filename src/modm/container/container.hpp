@@ -12,13 +12,19 @@
 
 #include "container/deque.hpp"
 #include "container/queue.hpp"
+#include "container/bounded_priority_queue.hpp"
 #include "container/stack.hpp"
 
 #include "container/linked_list.hpp"
 #include "container/doubly_linked_list.hpp"
+#include "container/intrusive_list.hpp"
+#include "container/intrusive_doubly_linked_list.hpp"
 
 #include "container/dynamic_array.hpp"
 
+#include "container/static_hash_map.hpp"
+#include "container/static_sorted_vector.hpp"
+
 #include "container/pair.hpp"
 #include "container/smart_pointer.hpp"
 
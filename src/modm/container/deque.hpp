@@ -15,8 +15,10 @@
 #ifndef	MODM_DEQUE_HPP
 #define	MODM_DEQUE_HPP
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <type_traits>
 #include <iterator>
 
@@ -45,6 +47,24 @@ namespace modm
 	 * Up to a size of 254 small index variables with 8-bits are used, after
 	 * this they are switched to 16-bit.
 	 *
+	 * The items can also be accessed in bulk without copying them one by one:
+	 * getOccupiedSpans() and getFreeSpans() return the occupied and the free
+	 * part of the ring buffer as two contiguous spans each, since either may
+	 * wrap around the end of the buffer. After writing into the free spans,
+	 * commit() appends the written items. After reading from the occupied
+	 * spans, consume() removes the read items from the front.
+	 *
+	 * \code
+	 * modm::BoundedDeque<uint8_t, 256> buffer;
+	 * auto free = buffer.getFreeSpans();
+	 * std::size_t received = uart.read(free[0].data(), free[0].size());
+	 * buffer.commit(received);
+	 *
+	 * for (std::span<const uint8_t> span : buffer.getOccupiedSpans())
+	 *     file.write(span.data(), span.size());
+	 * buffer.consume(buffer.getSize());
+	 * \endcode
+	 *
 	 * \warning	This class don't check if the container is empty before
 	 * 			a pop-operation. You have to do this by yourself!
 	 *
@@ -63,6 +83,10 @@ namespace modm
 
 		using Size = Index;
 
+		/// Contiguous parts of the ring buffer, the second one may be empty
+		using Spans = std::array<std::span<T>, 2>;
+		using ConstSpans = std::array<std::span<const T>, 2>;
+
 	public:
 		BoundedDeque();
 
@@ -184,6 +208,42 @@ namespace modm
 		void
 		removeFront();
 
+		/**
+		 * \brief	Get the items from front to back as two spans
+		 *
+		 * The second span is only used if the items wrap around the end of
+		 * the buffer.
+		 */
+		Spans
+		getOccupiedSpans();
+
+		ConstSpans
+		getOccupiedSpans() const;
+
+		/**
+		 * \brief	Get the free space after the back as two spans
+		 *
+		 * The items written into the spans are appended by commit().
+		 */
+		Spans
+		getFreeSpans();
+
+		/**
+		 * \brief	Append `n` items written into the free spans
+		 *
+		 * \warning	Please make sure that `n` <= getMaxSize() - getSize().
+		 */
+		void
+		commit(Size n);
+
+		/**
+		 * \brief	Remove `n` items from the front
+		 *
+		 * \warning	Please make sure that `n` <= getSize().
+		 */
+		void
+		consume(Size n);
+
 	public:
 		/**
 		 * \brief	Bidirectional const iterator
@@ -14,6 +14,8 @@
 	#error	"Don't include this file directly use 'container/deque.hpp' instead!"
 #endif
 
+#include <algorithm>
+
 // ----------------------------------------------------------------------------
 
 template<typename T, std::size_t N>
@@ -290,6 +292,61 @@ modm::BoundedDeque<T, N>::removeFront()
 
 // ----------------------------------------------------------------------------
 
+template<typename T, std::size_t N>
+typename modm::BoundedDeque<T, N>::Spans
+modm::BoundedDeque<T, N>::getOccupiedSpans()
+{
+	const std::size_t first = std::min<std::size_t>(this->size, N - this->tail);
+	return {std::span<T>(this->buffer + this->tail, first),
+			std::span<T>(this->buffer, this->size - first)};
+}
+
+template<typename T, std::size_t N>
+typename modm::BoundedDeque<T, N>::ConstSpans
+modm::BoundedDeque<T, N>::getOccupiedSpans() const
+{
+	const std::size_t first = std::min<std::size_t>(this->size, N - this->tail);
+	return {std::span<const T>(this->buffer + this->tail, first),
+			std::span<const T>(this->buffer, this->size - first)};
+}
+
+template<typename T, std::size_t N>
+typename modm::BoundedDeque<T, N>::Spans
+modm::BoundedDeque<T, N>::getFreeSpans()
+{
+	const std::size_t start = (this->head >= (N - 1)) ? 0 : (this->head + 1);
+	const std::size_t free = N - this->size;
+	const std::size_t first = std::min<std::size_t>(free, N - start);
+	return {std::span<T>(this->buffer + start, first),
+			std::span<T>(this->buffer, free - first)};
+}
+
+template<typename T, std::size_t N>
+void
+modm::BoundedDeque<T, N>::commit(Size n)
+{
+	std::size_t index = this->head + n;
+	if (index >= N) {
+		index -= N;
+	}
+	this->head = index;
+	this->size += n;
+}
+
+template<typename T, std::size_t N>
+void
+modm::BoundedDeque<T, N>::consume(Size n)
+{
+	std::size_t index = this->tail + n;
+	if (index >= N) {
+		index -= N;
+	}
+	this->tail = index;
+	this->size -= n;
+}
+
+// ----------------------------------------------------------------------------
+
 template<typename T, std::size_t N>
 modm::BoundedDeque<T, N>::const_iterator::const_iterator() :
 	index(0), parent(0), count(0)
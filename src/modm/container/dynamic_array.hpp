@@ -20,6 +20,7 @@
 #include <modm/utils/allocator.hpp>
 #include <initializer_list>
 #include <iterator>
+#include <ratio>
 
 namespace modm
 {
@@ -36,17 +37,31 @@ namespace modm
 	 *
 	 * Reallocations may be a costly operation in terms of performance, since
 	 * they generally involve the entire storage space used by the
-	 * dynamic array to be copied to a new location. Therefore, whenever large
+	 * dynamic array to be moved to a new location. Therefore, whenever large
 	 * increases in size are planned for a dynamic array, it is recommended to
 	 * explicitly indicate a capacity for the dynamic array using member
 	 * function DynamicArray::reserve().
 	 *
+	 * The capacity grows geometrically by the \p Growth factor, so that
+	 * appending takes amortized constant time. Elements are moved to the new
+	 * storage, trivially copyable elements are copied with `memcpy()`.
+	 *
+	 * The first \p N elements are stored inside the dynamic array itself,
+	 * so that small arrays do not use the heap at all.
+	 *
+	 * \tparam	N		Number of elements stored inline (default: none)
+	 * \tparam	Growth	Factor by which the capacity grows as `std::ratio`
+	 * 					(default: 1.5)
+	 *
 	 * \author	Fabian Greif <fabian.greif@rwth-aachen.de>
 	 * \ingroup	modm_container
 	 */
-	template <typename T, typename Allocator = allocator::Dynamic<T> >
+	template <typename T, typename Allocator = allocator::Dynamic<T>,
+			  std::size_t N = 0, typename Growth = std::ratio<3, 2> >
 	class DynamicArray
 	{
+		static_assert(Growth::num > Growth::den, "The growth factor must be larger than one!");
+
 	public:
 		typedef std::size_t SizeType;
 	public:
@@ -87,11 +102,22 @@ namespace modm
 
 		DynamicArray(const DynamicArray& other);
 
+		/**
+		 * \brief	Move constructor
+		 *
+		 * Takes over the allocated storage of the other dynamic array, which
+		 * is left empty. Inline elements are moved one by one.
+		 */
+		DynamicArray(DynamicArray&& other);
+
 		~DynamicArray();
 
 		DynamicArray&
 		operator = (const DynamicArray& other);
 
+		DynamicArray&
+		operator = (DynamicArray&& other);
+
 		/**
 		 * \brief	Test whether dynamic array is empty
 		 *
@@ -215,6 +241,22 @@ namespace modm
 		void
 		append(const T& value);
 
+		/// Adds a new element at the end by moving \p value.
+		void
+		append(T&& value);
+
+		/**
+		 * \brief	Construct element at the end
+		 *
+		 * Constructs a new element in place at the end of the dynamic array
+		 * from the arguments, without creating a temporary.
+		 *
+		 * \return	the new element
+		 */
+		template <typename... Args>
+		T&
+		emplaceBack(Args&&... args);
+
 		/**
 		 * \brief	Delete last element
 		 *
@@ -378,17 +420,50 @@ namespace modm
 
 	private:
 		/*
-		 * Allocate a new buffer of size n and copy the elements from the
+		 * Allocate a new buffer of size n and move the elements from the
 		 * old buffer to the new buffer.
 		 */
 		void
 		relocate(SizeType n);
 
+		/// Move n elements into uninitialized storage and destroy the source.
+		static void
+		moveElements(T* destination, T* source, SizeType n);
+
+		T*
+		inlineValues()
+		{
+			return reinterpret_cast<T*>(inlineStorage.data);
+		}
+
+		bool
+		isInline() const
+		{
+			return (N > 0) and (this->values == reinterpret_cast<const T*>(inlineStorage.data));
+		}
+
+		/// Free the storage, if it was allocated.
+		void
+		deallocate();
+
+		template <std::size_t Size, typename = void>
+		struct InlineStorage
+		{
+			alignas(T) std::byte data[Size * sizeof(T)];
+		};
+		template <typename Dummy>
+		struct InlineStorage<0, Dummy>
+		{
+			static constexpr std::byte* data = nullptr;
+		};
+
 		Allocator allocator;
 
 		SizeType size;
 		SizeType capacity;
 		T* values;
+
+		[[no_unique_address]] InlineStorage<N> inlineStorage;
 	};
 }
 
@@ -17,87 +17,129 @@
 	#error	"Don't include this file directly, use 'vector.hpp' instead"
 #endif
 
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
 // ----------------------------------------------------------------------------
-template <typename T, typename Allocator>
-modm::DynamicArray<T, Allocator>::DynamicArray(const Allocator& alloc) :
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+modm::DynamicArray<T, Allocator, N, Growth>::DynamicArray(const Allocator& alloc) :
 	allocator(alloc),
-	size(0), capacity(0), values(0)
+	size(0), capacity(N), values(inlineValues())
 {
 }
 
-template <typename T, typename Allocator>
-modm::DynamicArray<T, Allocator>::DynamicArray(SizeType n, const Allocator& alloc) :
-	allocator(alloc), size(0), capacity(n)
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+modm::DynamicArray<T, Allocator, N, Growth>::DynamicArray(SizeType n, const Allocator& alloc) :
+	allocator(alloc), size(0), capacity(N), values(inlineValues())
 {
-	this->values = this->allocator.allocate(n);
+	if (n > N) {
+		this->values = this->allocator.allocate(n);
+		this->capacity = n;
+	}
 }
 
-template <typename T, typename Allocator>
-modm::DynamicArray<T, Allocator>::DynamicArray(SizeType n, const T& value, const Allocator& alloc) :
-	allocator(alloc), size(n), capacity(n)
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+modm::DynamicArray<T, Allocator, N, Growth>::DynamicArray(SizeType n, const T& value, const Allocator& alloc) :
+	DynamicArray(n, alloc)
 {
-	this->values = this->allocator.allocate(n);
 	for (SizeType i = 0; i < n; ++i) {
 		allocator.construct(&this->values[i], value);
 	}
+	this->size = n;
 }
 
-template <typename T, typename Allocator>
-modm::DynamicArray<T, Allocator>::DynamicArray(std::initializer_list<T> init, const Allocator& alloc) :
-	allocator(alloc), size(init.size()), capacity(init.size())
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+modm::DynamicArray<T, Allocator, N, Growth>::DynamicArray(std::initializer_list<T> init, const Allocator& alloc) :
+	DynamicArray(init.size(), alloc)
 {
-	this->values = this->allocator.allocate(init.size());
-	std::size_t ii = 0;
-	for (auto value : init) {
-		allocator.construct(&this->values[ii], value);
-		++ii;
+	for (const T& value : init) {
+		allocator.construct(&this->values[this->size], value);
+		++this->size;
 	}
 }
 
-template <typename T, typename Allocator>
-modm::DynamicArray<T, Allocator>::DynamicArray(const DynamicArray& other) :
-	allocator(other.allocator),
-	size(other.size), capacity(other.capacity)
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+modm::DynamicArray<T, Allocator, N, Growth>::DynamicArray(const DynamicArray& other) :
+	DynamicArray(other.capacity, other.allocator)
 {
-	this->values = allocator.allocate(other.capacity);
-	for (SizeType i = 0; i < this->size; ++i) {
+	for (SizeType i = 0; i < other.size; ++i) {
 		this->allocator.construct(&this->values[i], other.values[i]);
 	}
+	this->size = other.size;
 }
 
-template <typename T, typename Allocator>
-modm::DynamicArray<T, Allocator>::~DynamicArray()
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+modm::DynamicArray<T, Allocator, N, Growth>::DynamicArray(DynamicArray&& other) :
+	DynamicArray(other.allocator)
+{
+	*this = std::move(other);
+}
+
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+modm::DynamicArray<T, Allocator, N, Growth>::~DynamicArray()
 {
 	for (SizeType i = 0; i < this->size; ++i) {
 		this->allocator.destroy(&this->values[i]);
 	}
-	this->allocator.deallocate(this->values);
+	this->deallocate();
 }
 
-template <typename T, typename Allocator>
-modm::DynamicArray<T, Allocator>&
-modm::DynamicArray<T, Allocator>::operator = (const DynamicArray& other)
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+modm::DynamicArray<T, Allocator, N, Growth>&
+modm::DynamicArray<T, Allocator, N, Growth>::operator = (const DynamicArray& other)
 {
-	for (SizeType i = 0; i < this->size; ++i) {
-		this->allocator.destroy(&this->values[i]);
+	if (this == &other) {
+		return *this;
+	}
+	this->removeAll();
+	if (other.size > this->capacity)
+	{
+		// the existing storage is reused if it is large enough
+		this->deallocate();
+		this->allocator = other.allocator;
+		this->values = this->allocator.allocate(other.capacity);
+		this->capacity = other.capacity;
 	}
-	this->allocator.deallocate(this->values);
 
-	this->allocator = other.allocator;
+	for (SizeType i = 0; i < other.size; ++i) {
+		this->allocator.construct(&this->values[i], other.values[i]);
+	}
 	this->size = other.size;
-	this->capacity = other.capacity;
-	this->values = this->allocator.allocate(this->capacity);
+	return *this;
+}
 
-	for (SizeType i = 0; i < this->size; ++i) {
-		this->allocator.construct(&this->values[i], other.values[i]);
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+modm::DynamicArray<T, Allocator, N, Growth>&
+modm::DynamicArray<T, Allocator, N, Growth>::operator = (DynamicArray&& other)
+{
+	if (this == &other) {
+		return *this;
+	}
+	this->clear();
+	this->allocator = other.allocator;
+
+	if (other.isInline())
+	{
+		// inline elements cannot be taken over, they must be moved
+		moveElements(this->values, other.values, other.size);
 	}
+	else
+	{
+		this->values = other.values;
+		this->capacity = other.capacity;
+		other.values = other.inlineValues();
+		other.capacity = N;
+	}
+	this->size = other.size;
+	other.size = 0;
 	return *this;
 }
 
 // ----------------------------------------------------------------------------
-template <typename T, typename Allocator>
+template <typename T, typename Allocator, std::size_t N, typename Growth>
 void
-modm::DynamicArray<T, Allocator>::reserve(SizeType n)
+modm::DynamicArray<T, Allocator, N, Growth>::reserve(SizeType n)
 {
 	if (n <= (this->capacity - this->size)) {
 		// capacity is already big enough, nothing to do.
@@ -109,24 +151,20 @@ modm::DynamicArray<T, Allocator>::reserve(SizeType n)
 }
 
 // ----------------------------------------------------------------------------
-template <typename T, typename Allocator>
+template <typename T, typename Allocator, std::size_t N, typename Growth>
 void
-modm::DynamicArray<T, Allocator>::clear()
+modm::DynamicArray<T, Allocator, N, Growth>::clear()
 {
-	for (SizeType i = 0; i < this->size; ++i) {
-		this->allocator.destroy(&this->values[i]);
-	}
-	this->allocator.deallocate(this->values);
-	this->values = 0;
-
-	this->size = 0;
-	this->capacity = 0;
+	this->removeAll();
+	this->deallocate();
+	this->values = this->inlineValues();
+	this->capacity = N;
 }
 
 // ----------------------------------------------------------------------------
-template <typename T, typename Allocator>
+template <typename T, typename Allocator, std::size_t N, typename Growth>
 void
-modm::DynamicArray<T, Allocator>::removeAll()
+modm::DynamicArray<T, Allocator, N, Growth>::removeAll()
 {
 	for (SizeType i = 0; i < this->size; ++i) {
 		this->allocator.destroy(&this->values[i]);
@@ -135,28 +173,53 @@ modm::DynamicArray<T, Allocator>::removeAll()
 }
 
 // ----------------------------------------------------------------------------
-template <typename T, typename Allocator>
+template <typename T, typename Allocator, std::size_t N, typename Growth>
 void
-modm::DynamicArray<T, Allocator>::append(const T& value)
+modm::DynamicArray<T, Allocator, N, Growth>::append(const T& value)
+{
+	this->emplaceBack(value);
+}
+
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+void
+modm::DynamicArray<T, Allocator, N, Growth>::append(T&& value)
+{
+	this->emplaceBack(std::move(value));
+}
+
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+template <typename... Args>
+T&
+modm::DynamicArray<T, Allocator, N, Growth>::emplaceBack(Args&&... args)
 {
 	if (this->capacity == this->size)
 	{
 		// allocate new memory if no more space is left
-		SizeType n = this->size + (this->size + 1) / 2;
-		if (n == 0) {
-			n = 1;
+		SizeType n = (this->size * Growth::num + Growth::den - 1) / Growth::den;
+		if (n <= this->size) {
+			n = this->size + 1;
 		}
-		this->relocate(n);
-	}
+		T* newBuffer = this->allocator.allocate(n);
 
-	this->allocator.construct(&this->values[this->size], value);
-	++this->size;
+		// construct the new element first, the arguments may refer to the
+		// old elements
+		this->allocator.construct(&newBuffer[this->size], std::forward<Args>(args)...);
+		moveElements(newBuffer, this->values, this->size);
+		this->deallocate();
+
+		this->values = newBuffer;
+		this->capacity = n;
+	}
+	else {
+		this->allocator.construct(&this->values[this->size], std::forward<Args>(args)...);
+	}
+	return this->values[this->size++];
 }
 
 // ----------------------------------------------------------------------------
-template <typename T, typename Allocator>
+template <typename T, typename Allocator, std::size_t N, typename Growth>
 void
-modm::DynamicArray<T, Allocator>::removeBack()
+modm::DynamicArray<T, Allocator, N, Growth>::removeBack()
 {
 	--this->size;
 
@@ -165,42 +228,66 @@ modm::DynamicArray<T, Allocator>::removeBack()
 }
 
 // ----------------------------------------------------------------------------
-template <typename T, typename Allocator>
+template <typename T, typename Allocator, std::size_t N, typename Growth>
 void
-modm::DynamicArray<T, Allocator>::relocate(SizeType n)
+modm::DynamicArray<T, Allocator, N, Growth>::relocate(SizeType n)
 {
+	T* newBuffer = allocator.allocate(n);
+	moveElements(newBuffer, this->values, this->size);
+	this->deallocate();
+
+	this->values = newBuffer;
 	this->capacity = n;
+}
 
-	T* newBuffer = allocator.allocate(n);
-	for (SizeType i = 0; i < this->size; ++i) {
-		this->allocator.construct(&newBuffer[i], this->values[i]);
-		this->allocator.destroy(&this->values[i]);
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+void
+modm::DynamicArray<T, Allocator, N, Growth>::moveElements(T* destination, T* source, SizeType n)
+{
+	if constexpr (std::is_trivially_copyable_v<T>)
+	{
+		if (n) {
+			std::memcpy(static_cast<void*>(destination), source, n * sizeof(T));
+		}
 	}
-	this->allocator.deallocate(this->values);
+	else
+	{
+		for (SizeType i = 0; i < n; ++i) {
+			Allocator::construct(&destination[i], std::move(source[i]));
+			Allocator::destroy(&source[i]);
+		}
+	}
+}
 
-	this->values = newBuffer;
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+void
+modm::DynamicArray<T, Allocator, N, Growth>::deallocate()
+{
+	if (this->values != nullptr and not this->isInline()) {
+		this->allocator.deallocate(this->values);
+	}
 }
 
 // ----------------------------------------------------------------------------
-template <typename T, typename Allocator>
-typename modm::DynamicArray<T, Allocator>::iterator
-modm::DynamicArray<T, Allocator>::begin()
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+typename modm::DynamicArray<T, Allocator, N, Growth>::iterator
+modm::DynamicArray<T, Allocator, N, Growth>::begin()
 {
 	return iterator(this, 0);
 }
 
-template <typename T, typename Allocator>
-typename modm::DynamicArray<T, Allocator>::iterator
-modm::DynamicArray<T, Allocator>::end()
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+typename modm::DynamicArray<T, Allocator, N, Growth>::iterator
+modm::DynamicArray<T, Allocator, N, Growth>::end()
 {
 	return iterator(this, size);
 }
 
-template <typename T, typename Allocator>
-typename modm::DynamicArray<T, Allocator>::iterator
-modm::DynamicArray<T, Allocator>::find(const T& value)
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+typename modm::DynamicArray<T, Allocator, N, Growth>::iterator
+modm::DynamicArray<T, Allocator, N, Growth>::find(const T& value)
 {
-	modm::DynamicArray<T, Allocator>::iterator iter = this->begin();
+	modm::DynamicArray<T, Allocator, N, Growth>::iterator iter = this->begin();
 
 	for(; iter != this->end(); ++iter)
 	{
@@ -213,25 +300,25 @@ modm::DynamicArray<T, Allocator>::find(const T& value)
 	return iter;
 }
 
-template <typename T, typename Allocator>
-typename modm::DynamicArray<T, Allocator>::const_iterator
-modm::DynamicArray<T, Allocator>::begin() const
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+typename modm::DynamicArray<T, Allocator, N, Growth>::const_iterator
+modm::DynamicArray<T, Allocator, N, Growth>::begin() const
 {
 	return const_iterator(this, 0);
 }
 
-template <typename T, typename Allocator>
-typename modm::DynamicArray<T, Allocator>::const_iterator
-modm::DynamicArray<T, Allocator>::end() const
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+typename modm::DynamicArray<T, Allocator, N, Growth>::const_iterator
+modm::DynamicArray<T, Allocator, N, Growth>::end() const
 {
 	return const_iterator(this, size);
 }
 
-template <typename T, typename Allocator>
-typename modm::DynamicArray<T, Allocator>::const_iterator
-modm::DynamicArray<T, Allocator>::find(const T& value) const
+template <typename T, typename Allocator, std::size_t N, typename Growth>
+typename modm::DynamicArray<T, Allocator, N, Growth>::const_iterator
+modm::DynamicArray<T, Allocator, N, Growth>::find(const T& value) const
 {
-	modm::DynamicArray<T, Allocator>::const_iterator iter = this->begin();
+	modm::DynamicArray<T, Allocator, N, Growth>::const_iterator iter = this->begin();
 
 	for(; iter != this->end(); ++iter)
 	{
@@ -0,0 +1,261 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace modm
+{
+
+template< typename T, typename Tag >
+class IntrusiveDoublyLinkedList;
+
+/**
+ * Link hook of an element of a `modm::IntrusiveDoublyLinkedList`.
+ *
+ * The element type inherits from the hook. An element can be part of several
+ * lists at once by inheriting from hooks with different tags. Copying an
+ * element does not copy its links.
+ *
+ * Since the list is circular, an element can unlink itself without a
+ * reference to its list. An element is also unlinked when it is destroyed.
+ *
+ * @ingroup	modm_container
+ */
+template< typename Tag = void >
+class IntrusiveDoublyLinkedListHook
+{
+	template< typename, typename >
+	friend class IntrusiveDoublyLinkedList;
+
+public:
+	IntrusiveDoublyLinkedListHook() = default;
+	IntrusiveDoublyLinkedListHook(const IntrusiveDoublyLinkedListHook&) {}
+	IntrusiveDoublyLinkedListHook& operator=(const IntrusiveDoublyLinkedListHook&) { return *this; }
+
+	~IntrusiveDoublyLinkedListHook()
+	{ unlink(); }
+
+	/// @return `true` if the element is part of a list.
+	bool
+	isLinked() const
+	{ return next != nullptr; }
+
+	/// Removes the element from its list in constant time.
+	void
+	unlink()
+	{
+		if (next == nullptr) return;
+		next->previous = previous;
+		previous->next = next;
+		next = previous = nullptr;
+	}
+
+private:
+	void
+	linkBefore(IntrusiveDoublyLinkedListHook* position)
+	{
+		next = position;
+		previous = position->previous;
+		previous->next = this;
+		position->previous = this;
+	}
+
+	IntrusiveDoublyLinkedListHook* next{nullptr};
+	IntrusiveDoublyLinkedListHook* previous{nullptr};
+};
+
+/**
+ * Doubly-linked list without memory allocation.
+ *
+ * Instead of copying the values into allocated nodes like
+ * `modm::DoublyLinkedList`, the list links the elements themselves via the
+ * `modm::IntrusiveDoublyLinkedListHook` they inherit from. All operations
+ * except `getSize()` take constant time and never allocate memory, including
+ * removing an element from anywhere in the list.
+ *
+ * The list does not own its elements: they must outlive their membership in
+ * the list and may only be part of one list per hook at a time. Destroying
+ * an element removes it from the list, and destroying the list unlinks all
+ * its elements.
+ *
+ * ```cpp
+ * struct Task : modm::IntrusiveDoublyLinkedListHook<>
+ * {
+ *     uint8_t priority;
+ * };
+ * modm::IntrusiveDoublyLinkedList<Task> ready;
+ * Task task;
+ * ready.append(task);
+ * for (Task& t : ready) { ... }
+ * ready.remove(task); // or task.unlink();
+ * ```
+ *
+ * @tparam	T	element type, which inherits from
+ *				`IntrusiveDoublyLinkedListHook<Tag>`.
+ * @tparam	Tag	selects the hook, if the element inherits from several.
+ *
+ * @ingroup	modm_container
+ */
+template< typename T, typename Tag = void >
+class IntrusiveDoublyLinkedList
+{
+	using Hook = IntrusiveDoublyLinkedListHook<Tag>;
+
+public:
+	using Size = std::size_t;
+
+	IntrusiveDoublyLinkedList()
+	{ root.next = root.previous = &root; }
+
+	IntrusiveDoublyLinkedList(const IntrusiveDoublyLinkedList&) = delete;
+	IntrusiveDoublyLinkedList& operator=(const IntrusiveDoublyLinkedList&) = delete;
+
+	~IntrusiveDoublyLinkedList()
+	{ removeAll(); }
+
+	bool
+	isEmpty() const
+	{ return root.next == &root; }
+
+	/// @warning This method is slow because it has to iterate through all
+	///          elements.
+	Size
+	getSize() const
+	{
+		Size size{0};
+		for (const Hook* hook = root.next; hook != &root; hook = hook->next) size++;
+		return size;
+	}
+
+	/// Insert in front
+	void
+	prepend(T& element)
+	{ static_cast<Hook&>(element).linkBefore(root.next); }
+
+	/// Insert at the end of the list
+	void
+	append(T& element)
+	{ static_cast<Hook&>(element).linkBefore(&root); }
+
+	/// Remove the first element. The list must not be empty.
+	void
+	removeFront()
+	{ root.next->unlink(); }
+
+	/// Remove the last element. The list must not be empty.
+	void
+	removeBack()
+	{ root.previous->unlink(); }
+
+	/// Remove an element of this list in constant time.
+	void
+	remove(T& element)
+	{ static_cast<Hook&>(element).unlink(); }
+
+	/// Unlink all elements.
+	void
+	removeAll()
+	{
+		while (not isEmpty()) removeFront();
+	}
+
+	T&
+	getFront()
+	{ return *static_cast<T*>(root.next); }
+
+	const T&
+	getFront() const
+	{ return *static_cast<const T*>(root.next); }
+
+	T&
+	getBack()
+	{ return *static_cast<T*>(root.previous); }
+
+	const T&
+	getBack() const
+	{ return *static_cast<const T*>(root.previous); }
+
+public:
+	template< typename Value, typename HookType >
+	class Iterator
+	{
+		friend class IntrusiveDoublyLinkedList;
+
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = std::remove_const_t<Value>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Value*;
+		using reference = Value&;
+
+		Iterator() = default;
+
+		Value& operator*() const { return *static_cast<Value*>(hook); }
+		Value* operator->() const { return static_cast<Value*>(hook); }
+
+		Iterator& operator++() { hook = hook->next; return *this; }
+		Iterator operator++(int) { Iterator tmp{*this}; hook = hook->next; return tmp; }
+		Iterator& operator--() { hook = hook->previous; return *this; }
+		Iterator operator--(int) { Iterator tmp{*this}; hook = hook->previous; return tmp; }
+
+		bool operator==(const Iterator& other) const { return hook == other.hook; }
+		bool operator!=(const Iterator& other) const { return hook != other.hook; }
+
+	private:
+		explicit Iterator(HookType* hook) : hook(hook) {}
+		HookType* hook{nullptr};
+	};
+
+	using iterator = Iterator<T, Hook>;
+	using const_iterator = Iterator<const T, const Hook>;
+
+	iterator
+	begin()
+	{ return iterator{root.next}; }
+
+	iterator
+	end()
+	{ return iterator{&root}; }
+
+	const_iterator
+	begin() const
+	{ return const_iterator{root.next}; }
+
+	const_iterator
+	end() const
+	{ return const_iterator{&root}; }
+
+	/// Insert an element before the position.
+	iterator
+	insert(iterator position, T& element)
+	{
+		static_cast<Hook&>(element).linkBefore(position.hook);
+		return iterator{static_cast<Hook*>(&element)};
+	}
+
+	/// Remove the element at the position.
+	/// @return an iterator to the element after the removed element.
+	iterator
+	erase(iterator position)
+	{
+		Hook* next = position.hook->next;
+		position.hook->unlink();
+		return iterator{next};
+	}
+
+private:
+	// The root is not an element, it only links the back to the front
+	Hook root;
+};
+
+}	// namespace modm
@@ -0,0 +1,243 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace modm
+{
+
+template< typename T, typename Tag >
+class IntrusiveList;
+
+/**
+ * Link hook of an element of a `modm::IntrusiveList`.
+ *
+ * The element type inherits from the hook. An element can be part of several
+ * lists at once by inheriting from hooks with different tags. Copying an
+ * element does not copy its link.
+ *
+ * @ingroup	modm_container
+ */
+template< typename Tag = void >
+class IntrusiveListHook
+{
+	template< typename, typename >
+	friend class IntrusiveList;
+
+public:
+	IntrusiveListHook() = default;
+	IntrusiveListHook(const IntrusiveListHook&) {}
+	IntrusiveListHook& operator=(const IntrusiveListHook&) { return *this; }
+
+private:
+	IntrusiveListHook* next{nullptr};
+};
+
+/**
+ * Singly-linked list without memory allocation.
+ *
+ * Instead of copying the values into allocated nodes like `modm::LinkedList`,
+ * the list links the elements themselves via the `modm::IntrusiveListHook`
+ * they inherit from. Appending and removing elements therefore never
+ * allocates memory and takes constant time, only `remove()` of an arbitrary
+ * element has to search the list. Use `modm::IntrusiveDoublyLinkedList` to
+ * remove arbitrary elements in constant time.
+ *
+ * The list does not own its elements: they must outlive their membership in
+ * the list and may only be part of one list per hook at a time.
+ *
+ * ```cpp
+ * struct Message : modm::IntrusiveListHook<>
+ * {
+ *     uint16_t identifier;
+ * };
+ * modm::IntrusiveList<Message> list;
+ * Message message;
+ * list.append(message);
+ * for (Message& msg : list) { ... }
+ * list.removeFront();
+ * ```
+ *
+ * @tparam	T	element type, which inherits from `IntrusiveListHook<Tag>`.
+ * @tparam	Tag	selects the hook, if the element inherits from several.
+ *
+ * @ingroup	modm_container
+ */
+template< typename T, typename Tag = void >
+class IntrusiveList
+{
+	using Hook = IntrusiveListHook<Tag>;
+
+public:
+	using Size = std::size_t;
+
+	IntrusiveList() = default;
+	IntrusiveList(const IntrusiveList&) = delete;
+	IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+	~IntrusiveList()
+	{ removeAll(); }
+
+	bool
+	isEmpty() const
+	{ return front == nullptr; }
+
+	/// @warning This method is slow because it has to iterate through all
+	///          elements.
+	Size
+	getSize() const
+	{
+		Size size{0};
+		for (const Hook* hook = front; hook; hook = hook->next) size++;
+		return size;
+	}
+
+	/// Insert in front
+	void
+	prepend(T& element)
+	{
+		Hook* hook = &element;
+		hook->next = front;
+		front = hook;
+		if (back == nullptr) back = hook;
+	}
+
+	/// Insert at the end of the list
+	void
+	append(T& element)
+	{
+		Hook* hook = &element;
+		hook->next = nullptr;
+		if (back) back->next = hook;
+		else front = hook;
+		back = hook;
+	}
+
+	/// Remove the first element. The list must not be empty.
+	void
+	removeFront()
+	{
+		Hook* hook = front;
+		front = hook->next;
+		if (front == nullptr) back = nullptr;
+		hook->next = nullptr;
+	}
+
+	/// Remove an element by searching the list.
+	/// @return `false` if the element is not part of the list.
+	bool
+	remove(T& element)
+	{
+		Hook* hook = &element;
+		Hook* previous{nullptr};
+		for (Hook* current = front; current; previous = current, current = current->next)
+		{
+			if (current != hook) continue;
+			if (previous) previous->next = hook->next;
+			else front = hook->next;
+			if (back == hook) back = previous;
+			hook->next = nullptr;
+			return true;
+		}
+		return false;
+	}
+
+	/// Unlink all elements.
+	void
+	removeAll()
+	{
+		while (front) removeFront();
+	}
+
+	T&
+	getFront()
+	{ return *static_cast<T*>(front); }
+
+	const T&
+	getFront() const
+	{ return *static_cast<const T*>(front); }
+
+	T&
+	getBack()
+	{ return *static_cast<T*>(back); }
+
+	const T&
+	getBack() const
+	{ return *static_cast<const T*>(back); }
+
+public:
+	template< typename Value, typename HookType >
+	class Iterator
+	{
+		friend class IntrusiveList;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::remove_const_t<Value>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Value*;
+		using reference = Value&;
+
+		Iterator() = default;
+
+		Value& operator*() const { return *static_cast<Value*>(hook); }
+		Value* operator->() const { return static_cast<Value*>(hook); }
+
+		Iterator& operator++() { hook = hook->next; return *this; }
+		Iterator operator++(int) { Iterator tmp{*this}; hook = hook->next; return tmp; }
+
+		bool operator==(const Iterator& other) const { return hook == other.hook; }
+		bool operator!=(const Iterator& other) const { return hook != other.hook; }
+
+	private:
+		explicit Iterator(HookType* hook) : hook(hook) {}
+		HookType* hook{nullptr};
+	};
+
+	using iterator = Iterator<T, Hook>;
+	using const_iterator = Iterator<const T, const Hook>;
+
+	iterator
+	begin()
+	{ return iterator{front}; }
+
+	iterator
+	end()
+	{ return iterator{}; }
+
+	const_iterator
+	begin() const
+	{ return const_iterator{front}; }
+
+	const_iterator
+	end() const
+	{ return const_iterator{}; }
+
+	/// Remove the element after the position in constant time.
+	/// @return an iterator to the element after the removed element.
+	iterator
+	removeAfter(iterator position)
+	{
+		Hook* hook = position.hook->next;
+		position.hook->next = hook->next;
+		if (back == hook) back = position.hook;
+		hook->next = nullptr;
+		return iterator{position.hook->next};
+	}
+
+private:
+	Hook* front{nullptr};
+	Hook* back{nullptr};
+};
+
+}	// namespace modm
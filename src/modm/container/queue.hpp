@@ -101,6 +101,40 @@ namespace modm
 			c.removeFront();
 		}
 
+		/// Queued elements as two contiguous spans, see BoundedDeque
+		inline auto
+		getOccupiedSpans()
+		{
+			return c.getOccupiedSpans();
+		}
+
+		inline auto
+		getOccupiedSpans() const
+		{
+			return c.getOccupiedSpans();
+		}
+
+		/// Free space as two contiguous spans, see BoundedDeque
+		inline auto
+		getFreeSpans()
+		{
+			return c.getFreeSpans();
+		}
+
+		/// Push `n` elements written into the free spans
+		inline void
+		commit(Size n)
+		{
+			c.commit(n);
+		}
+
+		/// Pop `n` elements
+		inline void
+		consume(Size n)
+		{
+			c.consume(n);
+		}
+
 	protected:
 		Container c;
 	};
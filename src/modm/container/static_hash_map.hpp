@@ -0,0 +1,423 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <modm/architecture/interface/assert.hpp>
+
+namespace modm
+{
+
+/**
+ * Default hash of the `modm::StaticHashMap` for integral and enum keys.
+ *
+ * Unlike `std::hash` it can be used in constant expressions and is available
+ * on all targets. The map mixes the bits of the hash itself, so the value is
+ * returned unchanged.
+ *
+ * @ingroup	modm_container
+ */
+template< typename Key >
+struct StaticHash
+{
+	static_assert(std::is_integral_v<Key> or std::is_enum_v<Key>,
+			"Provide a hash function for keys that are not integral!");
+
+	constexpr std::size_t
+	operator()(const Key& key) const
+	{ return static_cast<std::size_t>(key); }
+};
+
+namespace detail
+{
+
+/// Robin Hood hash table shared by the map and the multimap.
+template< typename Key, typename Value, std::size_t N, typename Hash, typename KeyEqual, bool Multi >
+class StaticHashTable
+{
+	static_assert(N > 0, "size = 0 is not allowed");
+	static_assert(N < 65535, "size is limited to 65534 entries");
+
+public:
+	using Size = std::conditional_t< (N >= 255), uint16_t, uint8_t >;
+
+	struct Entry
+	{
+		Key key{};
+		Value value{};
+	};
+
+public:
+	constexpr StaticHashTable() = default;
+
+	constexpr
+	StaticHashTable(std::initializer_list<Entry> init)
+	{
+		for (const Entry& entry : init)
+		{
+			if (not insert(entry.key, entry.value)) {
+				tooManyEntries();
+			}
+		}
+	}
+
+	constexpr bool
+	isEmpty() const
+	{ return size == 0; }
+
+	constexpr bool
+	isFull() const
+	{ return size == N; }
+
+	constexpr Size
+	getSize() const
+	{ return size; }
+
+	constexpr Size
+	getMaxSize() const
+	{ return N; }
+
+	/// Removes all entries.
+	constexpr void
+	clear()
+	{
+		for (Slot& slot : slots) slot = Slot{};
+		size = 0;
+	}
+
+	/**
+	 * Inserts a copy of the key and the value.
+	 *
+	 * @return `false` if the container is full or, for the map, if the key
+	 *         already exists.
+	 */
+	constexpr bool
+	insert(const Key& key, const Value& value)
+	{
+		if constexpr (not Multi)
+		{
+			if (findSlot(key) != N) return false;
+		}
+		if (isFull()) return false;
+
+		Slot item{Entry{key, value}, 1};
+		std::size_t index = home(key);
+		while (true)
+		{
+			Slot& slot = slots[index];
+			if (slot.distance == 0)
+			{
+				slot = std::move(item);
+				size++;
+				return true;
+			}
+			// steal the slot from entries which are closer to their home
+			if (slot.distance < item.distance) {
+				std::swap(slot, item);
+			}
+			item.distance++;
+			index = next(index);
+		}
+	}
+
+	/// @return the number of entries with this key.
+	constexpr Size
+	count(const Key& key) const
+	{
+		Size count{0};
+		forEachSlot(key, [&count](std::size_t) { count++; return not Multi; });
+		return count;
+	}
+
+	constexpr bool
+	contains(const Key& key) const
+	{ return findSlot(key) != N; }
+
+	/**
+	 * Removes the entries with this key.
+	 *
+	 * The following entries are shifted backwards, so that the lookup does
+	 * not need to skip deleted entries.
+	 *
+	 * @return the number of removed entries.
+	 */
+	constexpr Size
+	remove(const Key& key)
+	{
+		Size removed{0};
+		for (std::size_t index = findSlot(key); index != N; index = findSlot(key))
+		{
+			std::size_t following = next(index);
+			while (slots[following].distance > 1)
+			{
+				slots[index] = std::move(slots[following]);
+				slots[index].distance--;
+				index = following;
+				following = next(following);
+			}
+			slots[index] = Slot{};
+			size--;
+			removed++;
+			if constexpr (not Multi) break;
+		}
+		return removed;
+	}
+
+public:
+	template< typename EntryType, typename Table >
+	class Iterator
+	{
+		friend class StaticHashTable;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::remove_const_t<EntryType>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = EntryType*;
+		using reference = EntryType&;
+
+		constexpr Iterator() = default;
+
+		constexpr EntryType& operator*() const { return table->slots[index].entry; }
+		constexpr EntryType* operator->() const { return &table->slots[index].entry; }
+
+		constexpr Iterator& operator++() { index = table->skipEmpty(index + 1); return *this; }
+		constexpr Iterator operator++(int) { Iterator tmp{*this}; ++(*this); return tmp; }
+
+		constexpr bool operator==(const Iterator& other) const { return index == other.index; }
+		constexpr bool operator!=(const Iterator& other) const { return index != other.index; }
+
+	private:
+		constexpr Iterator(Table* table, std::size_t index) : table(table), index(index) {}
+
+		Table* table{nullptr};
+		std::size_t index{N};
+	};
+
+	/// Iterates over all entries in an unspecified order.
+	using iterator = Iterator<Entry, StaticHashTable>;
+	using const_iterator = Iterator<const Entry, const StaticHashTable>;
+
+	constexpr iterator
+	begin()
+	{ return iterator{this, skipEmpty(0)}; }
+
+	constexpr iterator
+	end()
+	{ return iterator{this, N}; }
+
+	constexpr const_iterator
+	begin() const
+	{ return const_iterator{this, skipEmpty(0)}; }
+
+	constexpr const_iterator
+	end() const
+	{ return const_iterator{this, N}; }
+
+protected:
+	struct Slot
+	{
+		Entry entry{};
+		/// Distance from the home slot plus one, zero if the slot is empty
+		Size distance{0};
+	};
+
+	constexpr std::size_t
+	home(const Key& key) const
+	{
+		// Fibonacci hashing spreads consecutive keys over the whole table
+		uint32_t value = static_cast<uint32_t>(Hash{}(key)) * 2654435769ul;
+		value ^= value >> 16;
+		return value % N;
+	}
+
+	static constexpr std::size_t
+	next(std::size_t index)
+	{ return (index + 1 == N) ? 0 : (index + 1); }
+
+	constexpr std::size_t
+	skipEmpty(std::size_t index) const
+	{
+		while (index < N and slots[index].distance == 0) index++;
+		return index;
+	}
+
+	/**
+	 * Calls `function(index)` for the slots with this key until it returns
+	 * `true`. Since entries are ordered by the distance to their home slot,
+	 * the search stops at the first entry that is closer to its home slot
+	 * than the key would be.
+	 */
+	template< typename Function >
+	constexpr void
+	forEachSlot(const Key& key, Function&& function) const
+	{
+		std::size_t index = home(key);
+		for (Size distance = 1; slots[index].distance >= distance; distance++)
+		{
+			if (KeyEqual{}(slots[index].entry.key, key) and function(index)) return;
+			index = next(index);
+			if (distance == N) return;
+		}
+	}
+
+	/// @return the index of the first slot with this key, or N.
+	constexpr std::size_t
+	findSlot(const Key& key) const
+	{
+		std::size_t found{N};
+		forEachSlot(key, [&found](std::size_t index) { found = index; return true; });
+		return found;
+	}
+
+	static void
+	tooManyEntries()
+	{
+		// not constexpr, so that constant evaluation fails with an error
+		modm_assert(false, "hashmap.init", "Too many entries for the capacity of the StaticHashMap!");
+	}
+
+	std::array<Slot, N> slots{};
+	Size size{0};
+};
+
+}	// namespace detail
+
+/**
+ * Hash map with a fixed capacity and without memory allocation.
+ *
+ * The entries are stored in an array of `N` slots, which are searched with
+ * linear probing in Robin Hood order: entries that are far from their home
+ * slot take the place of entries that are closer to their home, so that the
+ * number of probed slots stays low even for a high load. Entries are removed
+ * by shifting the following entries back instead of leaving tombstones.
+ *
+ * The map is suitable for lookup tables of handlers and can be constructed at
+ * compile time from an initializer list, if the key, the value and the hash
+ * can be used in constant expressions:
+ *
+ * ```cpp
+ * constexpr modm::StaticHashMap<uint8_t, void(*)(), 16> handlers{
+ *     {0x10, onStart}, {0x11, onStop}, {0x20, onReset},
+ * };
+ * if (const auto* handler = handlers.find(id)) (*handler)();
+ * ```
+ *
+ * Lookups become slower when the map is almost full, so choose a capacity of
+ * about 25% more than the maximum number of entries. Key and value must be
+ * default constructible, since every slot contains one of each.
+ *
+ * @tparam	Key			key type
+ * @tparam	Value		value type
+ * @tparam	N			maximum number of entries, at most 65534
+ * @tparam	Hash		function object returning a `std::size_t` hash of the key
+ * @tparam	KeyEqual	function object comparing two keys
+ *
+ * @see		modm::StaticHashMultiMap
+ * @ingroup	modm_container
+ */
+template< typename Key, typename Value, std::size_t N,
+		  typename Hash = StaticHash<Key>, typename KeyEqual = std::equal_to<Key> >
+class StaticHashMap : public detail::StaticHashTable<Key, Value, N, Hash, KeyEqual, false>
+{
+	using Table = detail::StaticHashTable<Key, Value, N, Hash, KeyEqual, false>;
+
+public:
+	using Table::Table;
+
+	/// @return a pointer to the value of the key, or `nullptr`.
+	constexpr Value*
+	find(const Key& key)
+	{
+		const std::size_t index = this->findSlot(key);
+		return (index == N) ? nullptr : &this->slots[index].entry.value;
+	}
+
+	constexpr const Value*
+	find(const Key& key) const
+	{
+		const std::size_t index = this->findSlot(key);
+		return (index == N) ? nullptr : &this->slots[index].entry.value;
+	}
+
+	/**
+	 * Inserts the value or assigns it if the key already exists.
+	 *
+	 * @return `false` if the key does not exist and the map is full.
+	 */
+	constexpr bool
+	insertOrAssign(const Key& key, const Value& value)
+	{
+		if (Value* existing = find(key))
+		{
+			*existing = value;
+			return true;
+		}
+		return this->insert(key, value);
+	}
+};
+
+/**
+ * Hash map with a fixed capacity, which can store several values per key.
+ *
+ * Works like the `modm::StaticHashMap`, except that `insert()` does not
+ * check if the key already exists and the values of a key are accessed with
+ * `forEach()`. The values of a key are visited in an unspecified order.
+ *
+ * ```cpp
+ * modm::StaticHashMultiMap<uint8_t, Listener, 32> listeners;
+ * listeners.insert(event, listener);
+ * listeners.forEach(event, [&](Listener& listener) { listener(payload); });
+ * ```
+ *
+ * @see		modm::StaticHashMap
+ * @ingroup	modm_container
+ */
+template< typename Key, typename Value, std::size_t N,
+		  typename Hash = StaticHash<Key>, typename KeyEqual = std::equal_to<Key> >
+class StaticHashMultiMap : public detail::StaticHashTable<Key, Value, N, Hash, KeyEqual, true>
+{
+	using Table = detail::StaticHashTable<Key, Value, N, Hash, KeyEqual, true>;
+
+public:
+	using Table::Table;
+
+	/// Calls `function(value)` for each value of the key.
+	template< typename Function >
+	constexpr void
+	forEach(const Key& key, Function&& function)
+	{
+		this->forEachSlot(key, [this, &function](std::size_t index)
+		{
+			function(this->slots[index].entry.value);
+			return false;
+		});
+	}
+
+	template< typename Function >
+	constexpr void
+	forEach(const Key& key, Function&& function) const
+	{
+		this->forEachSlot(key, [this, &function](std::size_t index)
+		{
+			function(this->slots[index].entry.value);
+			return false;
+		});
+	}
+};
+
+}	// namespace modm
@@ -0,0 +1,216 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+namespace modm
+{
+
+/**
+ * Sorted array with a fixed capacity and without memory allocation.
+ *
+ * The items are kept in ascending order according to `Compare` in a
+ * contiguous array. Lookups use a binary search and take logarithmic time.
+ * Insertion and removal find the position with a binary search as well and
+ * then move the following items by one place, which is a single memory move
+ * for trivially copyable items.
+ *
+ * Compared to a sorted `modm::LinkedList` the vector does not allocate a node
+ * for every item and does not follow a pointer for every comparison, which
+ * makes it faster for small and medium sizes. Items with the same key keep
+ * the order in which they were inserted.
+ *
+ * ```cpp
+ * modm::StaticSortedVector<uint16_t, 32> identifiers;
+ * identifiers.insert(0x120);
+ * identifiers.insert(0x010);
+ * if (identifiers.contains(id)) accept(id);
+ * ```
+ *
+ * The items can only be read through the index operator and the iterators,
+ * since changing them could break the order. All member functions only access
+ * memory of the vector itself, so it can be used in interrupts, if the
+ * accesses are not interrupted by the main program. The items must be default
+ * constructible.
+ *
+ * @tparam	T		type of the items
+ * @tparam	N		maximum number of items, at most 65535
+ * @tparam	Compare	function object returning `true` if the first item is
+ * 					ordered before the second one
+ *
+ * @ingroup	modm_container
+ */
+template< typename T, std::size_t N, typename Compare = std::less<T> >
+class StaticSortedVector
+{
+	static_assert(N > 0, "size = 0 is not allowed");
+	static_assert(N <= 65535, "size is limited to 65535 items");
+
+public:
+	using Index = std::conditional_t< (N >= 256), uint16_t, uint8_t >;
+	using Size = Index;
+
+	using const_iterator = const T*;
+
+public:
+	constexpr StaticSortedVector() = default;
+
+	constexpr bool
+	isEmpty() const
+	{ return size == 0; }
+
+	constexpr bool
+	isNotEmpty() const
+	{ return size != 0; }
+
+	constexpr bool
+	isFull() const
+	{ return size == N; }
+
+	constexpr bool
+	isNotFull() const
+	{ return size != N; }
+
+	constexpr Size
+	getSize() const
+	{ return size; }
+
+	constexpr Size
+	getMaxSize() const
+	{ return N; }
+
+	/// Removes all items.
+	constexpr void
+	clear()
+	{ size = 0; }
+
+	/**
+	 * Inserts a copy of the value after all items which are not ordered after
+	 * it.
+	 *
+	 * @return `false` if the vector is full.
+	 */
+	constexpr bool
+	insert(const T& value)
+	{
+		if (isFull()) return false;
+
+		const Index index = upperBound(value);
+		std::move_backward(values.begin() + index, values.begin() + size,
+						   values.begin() + size + 1);
+		values[index] = value;
+		size++;
+		return true;
+	}
+
+	/// @return the index of the first item not ordered before the value.
+	constexpr Index
+	lowerBound(const T& value) const
+	{ return std::lower_bound(begin(), end(), value, Compare{}) - begin(); }
+
+	/// @return the index of the first item ordered after the value.
+	constexpr Index
+	upperBound(const T& value) const
+	{ return std::upper_bound(begin(), end(), value, Compare{}) - begin(); }
+
+	/// @return a pointer to the first item equivalent to the value, or `nullptr`.
+	constexpr const T*
+	find(const T& value) const
+	{
+		const Index index = lowerBound(value);
+		if (index == size or Compare{}(value, values[index])) return nullptr;
+		return &values[index];
+	}
+
+	constexpr bool
+	contains(const T& value) const
+	{ return find(value) != nullptr; }
+
+	/// @return the number of items equivalent to the value.
+	constexpr Size
+	count(const T& value) const
+	{ return upperBound(value) - lowerBound(value); }
+
+	/**
+	 * Removes all items equivalent to the value.
+	 *
+	 * @return the number of removed items.
+	 */
+	constexpr Size
+	remove(const T& value)
+	{
+		const Index first = lowerBound(value);
+		const Index last = upperBound(value);
+		std::move(values.begin() + last, values.begin() + size, values.begin() + first);
+		size -= last - first;
+		return last - first;
+	}
+
+	/**
+	 * Removes the item at the index.
+	 *
+	 * @warning	Please make sure `index` is valid: 0 <= `index` < getSize().
+	 */
+	constexpr void
+	removeAt(Index index)
+	{
+		std::move(values.begin() + index + 1, values.begin() + size, values.begin() + index);
+		size--;
+	}
+
+	/**
+	 * Returns the item at the index, counting from the first item.
+	 *
+	 * @warning	Please make sure `index` is valid: 0 <= `index` < getSize().
+	 */
+	constexpr const T&
+	operator[](Index index) const
+	{ return values[index]; }
+
+	/// Returns the first item. @warning The vector must not be empty!
+	constexpr const T&
+	getFront() const
+	{ return values[0]; }
+
+	/// Returns the last item. @warning The vector must not be empty!
+	constexpr const T&
+	getBack() const
+	{ return values[size - 1]; }
+
+	/// Removes the first item. @warning The vector must not be empty!
+	constexpr void
+	removeFront()
+	{ removeAt(0); }
+
+	/// Removes the last item. @warning The vector must not be empty!
+	constexpr void
+	removeBack()
+	{ size--; }
+
+	constexpr const_iterator
+	begin() const
+	{ return values.data(); }
+
+	constexpr const_iterator
+	end() const
+	{ return values.data() + size; }
+
+protected:
+	std::array<T, N> values{};
+	Size size{0};
+};
+
+}	// namespace modm
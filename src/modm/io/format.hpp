@@ -0,0 +1,418 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "iostream.hpp"
+
+namespace modm
+{
+
+/**
+ * Format string of `modm::format()`, which is passed as template argument.
+ *
+ * @ingroup modm_io
+ */
+template< std::size_t N >
+struct FormatString
+{
+	constexpr
+	FormatString(const char (&string)[N])
+	{
+		for (std::size_t ii = 0; ii < N; ii++) data[ii] = string[ii];
+	}
+
+	char data[N]{};
+};
+
+namespace detail
+{
+
+/// Options of a replacement field `{:[[fill]align][+][#][0][width][type]}`
+struct FormatSpec
+{
+	char fill{' '};
+	/// '<', '>', '^' or zero for the default alignment of the type
+	char align{0};
+	/// Writes a '+' in front of positive numbers
+	bool sign{false};
+	/// Writes "0x", "0b" or "0" in front of hexadecimal, binary and octal numbers
+	bool prefix{false};
+	/// Pads numbers with zeros between the sign and the digits
+	bool zero{false};
+	uint8_t width{0};
+	/// 'd', 'x', 'X', 'b', 'o', 'c', 's', 'p' or zero for the default of the type
+	char type{0};
+
+	constexpr bool operator==(const FormatSpec&) const = default;
+};
+
+/// A literal part of the format string or a replacement field
+struct FormatChunk
+{
+	/// Offset of the literal in the format string
+	uint16_t begin{0};
+	uint16_t length{0};
+	/// Index of the argument of the field or -1 for a literal
+	int16_t argument{-1};
+	FormatSpec spec{};
+};
+
+// These functions are not constexpr, so that parsing an invalid format string
+// fails to compile with their name in the error message.
+inline void format_string_contains_unmatched_brace() {}
+inline void format_string_contains_invalid_specifier() {}
+inline void format_string_contains_too_large_width() {}
+
+/// @return the index after the specifier
+constexpr std::size_t
+parseFormatSpec(const char* string, std::size_t index, std::size_t end, FormatSpec& spec)
+{
+	const auto is_align = [](char c) { return c == '<' or c == '>' or c == '^'; };
+	const auto at = [&](std::size_t ii) { return ii < end ? string[ii] : '\0'; };
+
+	if (is_align(at(index + 1)) and at(index) != '{' and at(index) != '}')
+	{
+		spec.fill = at(index);
+		spec.align = at(index + 1);
+		index += 2;
+	}
+	else if (is_align(at(index))) {
+		spec.align = at(index++);
+	}
+	if (at(index) == '+') { spec.sign = true; index++; }
+	if (at(index) == '#') { spec.prefix = true; index++; }
+	if (at(index) == '0') { spec.zero = true; index++; }
+
+	std::size_t width{0};
+	while (at(index) >= '0' and at(index) <= '9')
+	{
+		width = width * 10 + (at(index++) - '0');
+		if (width > 255) format_string_contains_too_large_width();
+	}
+	spec.width = uint8_t(width);
+
+	for (const char type : std::string_view("dxXbocsp"))
+	{
+		if (at(index) == type)
+		{
+			spec.type = type;
+			index++;
+			break;
+		}
+	}
+	if (at(index) != '}') format_string_contains_invalid_specifier();
+	return index;
+}
+
+/**
+ * Splits the format string into literals and replacement fields and calls
+ * `emit(chunk)` for each of them. Escaped braces `{{` and `}}` end a literal
+ * after the first brace.
+ */
+template< std::size_t N, typename Emit >
+constexpr void
+parseFormat(const char (&string)[N], Emit&& emit)
+{
+	constexpr std::size_t end = N - 1;
+	static_assert(end < 65535, "The format string is too long!");
+
+	const auto literal = [&emit](std::size_t begin, std::size_t stop)
+	{
+		if (stop > begin) emit(FormatChunk{uint16_t(begin), uint16_t(stop - begin)});
+	};
+
+	std::size_t begin{0};
+	int16_t argument{0};
+	for (std::size_t index = 0; index < end;)
+	{
+		const char c = string[index];
+		if (c != '{' and c != '}')
+		{
+			index++;
+			continue;
+		}
+		if (index + 1 < end and string[index + 1] == c)
+		{
+			literal(begin, index + 1);
+			index += 2;
+			begin = index;
+			continue;
+		}
+		if (c == '}') format_string_contains_unmatched_brace();
+
+		literal(begin, index);
+		FormatChunk field{0, 0, argument++};
+		index++;
+		if (index < end and string[index] == ':') {
+			index = parseFormatSpec(string, index + 1, end, field.spec);
+		}
+		if (index >= end or string[index] != '}') format_string_contains_unmatched_brace();
+		emit(field);
+		begin = ++index;
+	}
+	literal(begin, end);
+}
+
+/// The chunks of the format string, which are computed at compile time
+template< FormatString F >
+struct FormatChunks
+{
+	static constexpr std::size_t count = []
+	{
+		std::size_t count{0};
+		parseFormat(F.data, [&count](const FormatChunk&) { count++; });
+		return count;
+	}();
+
+	static constexpr std::size_t arguments = []
+	{
+		std::size_t arguments{0};
+		parseFormat(F.data, [&arguments](const FormatChunk& chunk) { arguments += (chunk.argument >= 0); });
+		return arguments;
+	}();
+
+	static constexpr std::array<FormatChunk, count> chunks = []
+	{
+		std::array<FormatChunk, count> chunks{};
+		std::size_t index{0};
+		parseFormat(F.data, [&](const FormatChunk& chunk) { chunks[index++] = chunk; });
+		return chunks;
+	}();
+
+	/// @return `true` if the chunk is a literal in front of a replacement field
+	static constexpr bool
+	precedesField(std::size_t index)
+	{
+		return chunks[index].argument < 0 and index + 1 < count and chunks[index + 1].argument >= 0;
+	}
+};
+
+/**
+ * A replacement field and the literal in front of it, which is passed to the
+ * formatter as one constant, so that a field only takes one call.
+ */
+struct FormatField
+{
+	const char* literal;
+	uint16_t length;
+	FormatSpec spec;
+};
+
+/// Pointers are written as hexadecimal numbers with "0x" prefix
+constexpr FormatSpec
+pointerSpec(FormatSpec spec)
+{
+	spec.type = 'x';
+	spec.prefix = true;
+	return spec;
+}
+
+/// The constant of the field in chunk `I` for an argument of type `T`
+template< FormatString F, std::size_t I, typename T >
+inline constexpr FormatField formatField = []
+{
+	using Chunks = FormatChunks<F>;
+	FormatField field{F.data, 0, Chunks::chunks[I].spec};
+	if (I > 0 and Chunks::precedesField(I - 1))
+	{
+		field.literal = F.data + Chunks::chunks[I - 1].begin;
+		field.length = Chunks::chunks[I - 1].length;
+	}
+	if constexpr (std::is_null_pointer_v<T> or
+				  (std::is_pointer_v<T> and not std::is_convertible_v<const T&, const char*>))
+	{
+		static_assert(Chunks::chunks[I].spec.type == 0 or Chunks::chunks[I].spec.type == 'p',
+				"Pointers are only formatted as pointer!");
+		field.spec = pointerSpec(field.spec);
+	}
+	return field;
+}();
+
+// The formatters write the literal of the field followed by the value.
+// They are shared by all format strings, so that a call site only passes the
+// constant of the field and the value for every argument.
+void
+formatSigned(IOStreamBuffer& buffer, const FormatField& field, int32_t value);
+
+void
+formatSigned(IOStreamBuffer& buffer, const FormatField& field, int64_t value);
+
+void
+formatUnsigned(IOStreamBuffer& buffer, const FormatField& field, uint32_t value);
+
+void
+formatUnsigned(IOStreamBuffer& buffer, const FormatField& field, uint64_t value);
+
+void
+formatCharacter(IOStreamBuffer& buffer, const FormatField& field, char value);
+
+void
+formatBoolean(IOStreamBuffer& buffer, const FormatField& field, bool value);
+
+void
+formatString(IOStreamBuffer& buffer, const FormatField& field, const char* value);
+
+void
+formatString(IOStreamBuffer& buffer, const FormatField& field, std::string_view value);
+
+void
+formatFloating(IOStreamBuffer& buffer, const FormatField& field, double value);
+
+/// Checks the field of the argument at compile time and calls its formatter
+template< const FormatField& Field, typename T >
+modm_always_inline void
+formatArgument(IOStreamBuffer& buffer, const T& value)
+{
+	constexpr FormatSpec S = Field.spec;
+	if constexpr (std::is_same_v<T, bool>)
+	{
+		static_assert(S.type == 0 or S.type == 's', "Booleans are only formatted as string!");
+		formatBoolean(buffer, Field, value);
+	}
+	else if constexpr (std::is_same_v<T, char> and (S.type == 0 or S.type == 'c')) {
+		formatCharacter(buffer, Field, value);
+	}
+	else if constexpr (std::is_same_v<T, char>) {
+		formatUnsigned(buffer, Field, uint32_t(uint8_t(value)));
+	}
+	else if constexpr (std::is_integral_v<T> and S.type == 'c')
+	{
+		static_assert(sizeof(T) <= sizeof(uint32_t), "Only integers up to 32-bit are formatted as character!");
+		formatCharacter(buffer, Field, char(value));
+	}
+	else if constexpr (std::is_integral_v<T>)
+	{
+		static_assert(S.type != 's' and S.type != 'p', "Integers are not formatted as string or pointer!");
+		if constexpr (std::is_signed_v<T> and sizeof(T) <= sizeof(uint32_t)) {
+			formatSigned(buffer, Field, int32_t(value));
+		} else if constexpr (std::is_signed_v<T>) {
+			formatSigned(buffer, Field, int64_t(value));
+		} else if constexpr (sizeof(T) <= sizeof(uint32_t)) {
+			formatUnsigned(buffer, Field, uint32_t(value));
+		} else {
+			formatUnsigned(buffer, Field, uint64_t(value));
+		}
+	}
+	else if constexpr (std::is_enum_v<T>) {
+		formatArgument<Field>(buffer, static_cast<std::underlying_type_t<T>>(value));
+	}
+	else if constexpr (std::is_floating_point_v<T>)
+	{
+		static_assert(S == FormatSpec{}, "Floating point values only support the {} field!");
+		static_assert(requires(IOStream& stream, const T& value) { stream << value; },
+				"Floating point formatting is disabled in the modm:io module!");
+		formatFloating(buffer, Field, value);
+	}
+	else if constexpr (std::is_convertible_v<const T&, const char*> and not std::is_null_pointer_v<T>)
+	{
+		static_assert(S.type == 0 or S.type == 's', "Strings are only formatted as string!");
+		formatString(buffer, Field, static_cast<const char*>(value));
+	}
+	else if constexpr (std::is_convertible_v<const T&, std::string_view> and not std::is_null_pointer_v<T>)
+	{
+		static_assert(S.type == 0 or S.type == 's', "Strings are only formatted as string!");
+		formatString(buffer, Field, std::string_view(value));
+	}
+	else if constexpr (std::is_pointer_v<T> or std::is_null_pointer_v<T>)
+	{
+		// the constant of the field formats the address as hexadecimal number
+		const uintptr_t address = reinterpret_cast<uintptr_t>(value);
+		if constexpr (sizeof(uintptr_t) <= sizeof(uint32_t)) {
+			formatUnsigned(buffer, Field, uint32_t(address));
+		} else {
+			formatUnsigned(buffer, Field, uint64_t(address));
+		}
+	}
+	else {
+		static_assert(sizeof(T) == 0, "This type is not supported by modm::format()!");
+	}
+}
+
+template< FormatString F, std::size_t I, typename Arguments >
+modm_always_inline void
+formatChunk(IOStreamBuffer& buffer, const Arguments& arguments)
+{
+	using Chunks = FormatChunks<F>;
+	constexpr FormatChunk chunk = Chunks::chunks[I];
+	if constexpr (chunk.argument < 0)
+	{
+		// a literal in front of a field is written by the formatter of the field
+		if constexpr (not Chunks::precedesField(I)) {
+			buffer.write(F.data + chunk.begin, chunk.length);
+		}
+	}
+	else
+	{
+		using T = std::remove_cvref_t<std::tuple_element_t<chunk.argument, Arguments>>;
+		formatArgument<formatField<F, I, T>>(buffer, std::get<chunk.argument>(arguments));
+	}
+}
+
+}	// namespace detail
+
+/**
+ * Writes the arguments into the replacement fields of the format string.
+ *
+ * The format string is parsed and checked against the types of the arguments
+ * at compile time, so that only one call per argument remains at run time.
+ * Each call passes a constant with the options of the field and the literal in
+ * front of it together with the value in its own type to a formatter, which is
+ * shared by all format strings. The fields use a subset of the `std::format`
+ * syntax `{:[[fill]align][+][#][0][width][type]}`:
+ *
+ * ```cpp
+ * modm::format<"x={} y={:08x} name={:>8}\n">(MODM_LOG_INFO, x, y, name);
+ * ```
+ *
+ * - align: `<` left, `>` right, `^` centered, numbers are aligned right and
+ *   strings left by default.
+ * - `+` writes the sign of positive numbers.
+ * - `#` writes `0x`, `0b` or `0` in front of `x`, `b` and `o`.
+ * - `0` pads numbers with zeros after the sign.
+ * - type: `d` decimal, `x`/`X` hexadecimal, `b` binary, `o` octal, `c`
+ *   character, `s` string and `p` pointer.
+ *
+ * Integers, enums, `char`, `bool`, strings and pointers are supported, floating
+ * point values are written with the `IOStream` and only support `{}`. Use
+ * `{{` and `}}` for literal braces. A wrong number of arguments, an invalid
+ * field or a type that does not fit the field fail to compile.
+ *
+ * The output is collected in a small buffer on the stack and written to the
+ * device in blocks. Unlike `IOStream::printf()` the arguments are not passed
+ * through varargs, and the mode of the stream is not used.
+ *
+ * @ingroup modm_io
+ */
+template< FormatString F, typename... Args >
+IOStream&
+format(IOStream& stream, const Args&... args)
+{
+	using Chunks = detail::FormatChunks<F>;
+	static_assert(Chunks::arguments == sizeof...(Args),
+			"The number of arguments does not match the format string!");
+
+	detail::IOStreamBuffer buffer(stream);
+	const std::tuple<const Args&...> arguments{args...};
+	[&]<std::size_t... I>(std::index_sequence<I...>)
+	{
+		(detail::formatChunk<F, I>(buffer, arguments), ...);
+	}(std::make_index_sequence<Chunks::count>{});
+	return stream;
+}
+
+}	// namespace modm
@@ -12,5 +12,6 @@
 // ----------------------------------------------------------------------------
 
 #include "io/iostream.hpp"
+#include "io/format.hpp"
 #include "io/iodevice.hpp"
 #include "io/iodevice_wrapper.hpp"
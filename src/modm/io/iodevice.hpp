@@ -14,6 +14,9 @@
 #ifndef MODM_IODEVICE_HPP
 #define MODM_IODEVICE_HPP
 
+#include <cstddef>
+#include <cstring>
+
 namespace modm
 {
 
@@ -37,8 +40,19 @@ public:
 	virtual inline void
 	write(const char* str)
 	{
-		char c;
-		while ( (c = *str++) ) write(c);
+		write(str, std::strlen(str));
+	}
+
+	/**
+	 * Write a block of characters
+	 *
+	 * The default implementation writes every character on its own, devices
+	 * with a buffer should override it to copy the whole block at once.
+	 */
+	virtual inline void
+	write(const char* data, std::size_t length)
+	{
+		for (std::size_t ii = 0; ii < length; ii++) write(data[ii]);
 	}
 
 	virtual void
@@ -47,6 +61,19 @@ public:
 	/// Read a single character
 	virtual bool
 	read(char& c) = 0;
+
+	/**
+	 * Read up to `length` characters, stops when no more are available
+	 *
+	 * @return the number of characters read
+	 */
+	virtual inline std::size_t
+	read(char* data, std::size_t length)
+	{
+		std::size_t count = 0;
+		while (count < length and read(data[count])) count++;
+		return count;
+	}
 };
 
 }	// namespace modm
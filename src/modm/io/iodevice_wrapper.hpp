@@ -16,6 +16,7 @@
 #define MODM_IODEVICE_WRAPPER_HPP
 
 #include <stdint.h>
+#include <cstddef>
 
 #include "iodevice.hpp"
 
@@ -32,6 +33,12 @@ IOBuffer
 };
 
 /**
+ * Forwards the IODevice calls to a static peripheral API.
+ *
+ * Blocks of characters are passed to `Device::write(const uint8_t*, size_t)`
+ * and `Device::read(uint8_t*, size_t)` if the peripheral provides them, so
+ * that a whole string is copied into the peripheral buffer in one call.
+ *
  * @ingroup		modm_io
  * @tparam		Device		Peripheral which should be wrapped
  * @tparam		behavior	preferred behavior when the Device buffer is full
@@ -54,17 +61,46 @@ public:
 		while(behavior == IOBuffer::BlockIfFull and not written);
 	}
 
+	void
+	write(const char* data, std::size_t length) override
+	{
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+		if constexpr (requires { Device::write(bytes, length); })
+		{
+			do
+			{
+				const std::size_t written = Device::write(bytes, length);
+				bytes += written;
+				length -= written;
+			}
+			while(behavior == IOBuffer::BlockIfFull and length);
+		}
+		else IODevice::write(data, length);
+	}
+
 	void
 	flush() override
 	{
 		Device::flushWriteBuffer();
 	}
 
+	using IODevice::read;
+
 	bool
 	read(char& c) override
 	{
 		return Device::read(reinterpret_cast<uint8_t&>(c));
 	}
+
+	std::size_t
+	read(char* data, std::size_t length) override
+	{
+		uint8_t* bytes = reinterpret_cast<uint8_t*>(data);
+		if constexpr (requires { Device::read(bytes, length); }) {
+			return Device::read(bytes, length);
+		}
+		else return IODevice::read(data, length);
+	}
 };
 
 /// @ingroup modm_io
@@ -87,17 +123,46 @@ public:
 		while(behavior == IOBuffer::BlockIfFull and not written);
 	}
 
+	void
+	write(const char* data, std::size_t length) override
+	{
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+		if constexpr (requires { device.write(bytes, length); })
+		{
+			do
+			{
+				const std::size_t written = device.write(bytes, length);
+				bytes += written;
+				length -= written;
+			}
+			while(behavior == IOBuffer::BlockIfFull and length);
+		}
+		else IODevice::write(data, length);
+	}
+
 	void
 	flush() override
 	{
 		device.flushWriteBuffer();
 	}
 
+	using IODevice::read;
+
 	bool
 	read(char& c) override
 	{
 		return device.read(reinterpret_cast<uint8_t&>(c));
 	}
+
+	std::size_t
+	read(char* data, std::size_t length) override
+	{
+		uint8_t* bytes = reinterpret_cast<uint8_t*>(data);
+		if constexpr (requires { device.read(bytes, length); }) {
+			return device.read(bytes, length);
+		}
+		else return IODevice::read(data, length);
+	}
 };
 
 }
@@ -14,27 +14,66 @@
 // ----------------------------------------------------------------------------
 
 #include "iostream.hpp"
+#include <cstring>
 #include <modm/architecture/interface/accessor.hpp>
 
+namespace
+{
+
+void
+putHex(modm::detail::IOStreamBuffer& buffer, uint8_t value)
+{
+	const auto fn_nibble = [&buffer](uint8_t nibble)
+	{
+		buffer.put( nibble + (nibble > 9 ? 'A' - 10 : '0') );
+	};
+	fn_nibble(value >> 4);
+	fn_nibble(value & 0xF);
+}
+
+void
+putBin(modm::detail::IOStreamBuffer& buffer, uint8_t value)
+{
+	for (uint_fast8_t ii = 0; ii < 8; ii++)
+	{
+		buffer.put(value & 0x80 ? '1' : '0');
+		value <<= 1;
+	}
+}
+
+}	// anonymous namespace
+
 namespace modm
 {
 
+detail::IOStreamBuffer::~IOStreamBuffer()
+{
+	flush();
+}
+
+void
+detail::IOStreamBuffer::write(const char* str, size_t length)
+{
+	if (length > sizeof(data) - size)
+	{
+		flush();
+		if (length >= sizeof(data)) {
+			device.write(str, length);
+			return;
+		}
+	}
+	std::memcpy(data + size, str, length);
+	size += length;
+}
+
+// ----------------------------------------------------------------------------
 IOStream&
 IOStream::get(char* s, size_t n)
 {
 	if(n < 1) {
 		return *this;
 	}
-	char cc;
-	size_t ii;
-	for(ii = 0; ii < (n-1); ++ii) {
-		if(device->read(cc)) {
-			s[ii] = cc;
-		} else {
-			break;
-		}
-	}
-	s[ii] = '\0';
+	s[device->read(s, n-1)] = '\0';
 	return *this;
 }
 
@@ -48,8 +87,8 @@ IOStream::operator << (const bool& v)
 			*this << (v ? IFSS("true") : IFSS("false"));
 			break;
 		case Mode::Hexadecimal:
-			device->write('0');
-			// fallthrough
+			device->write(v ? "01" : "00", 2);
+			break;
 		case Mode::Binary:
 			device->write(v ? '1' : '0');
 			break;
@@ -61,47 +100,55 @@ IOStream::operator << (const bool& v)
 void
 IOStream::writeHex(uint8_t value)
 {
-	const auto fn_nibble = [this](uint8_t nibble)
-	{
-		device->write( nibble + (nibble > 9 ? 'A' - 10 : '0') );
-	};
-	fn_nibble(value >> 4);
-	fn_nibble(value & 0xF);
+	writeHex(&value, 1);
+}
+
+void
+IOStream::writeHex(const uint8_t* bytes, size_t count)
+{
+	detail::IOStreamBuffer buffer(*device);
+	for (size_t ii = 0; ii < count; ii++)
+		putHex(buffer, bytes[ii]);
 }
 
 // ----------------------------------------------------------------------------
 void
 IOStream::writeBin(uint8_t value)
 {
-	for (uint_fast8_t ii = 0; ii < 8; ii++)
-	{
-		device->write(value & 0x80 ? '1' : '0');
-		value <<= 1;
-	}
+	writeBin(&value, 1);
+}
+
+void
+IOStream::writeBin(const uint8_t* bytes, size_t count)
+{
+	detail::IOStreamBuffer buffer(*device);
+	for (size_t ii = 0; ii < count; ii++)
+		putBin(buffer, bytes[ii]);
 }
 
 // ----------------------------------------------------------------------------
 void
 IOStream::writePointer(const void* p)
 {
-	device->write('0');
-	device->write('x');
+	detail::IOStreamBuffer buffer(*device);
+	buffer.put('0');
+	buffer.put('x');
 	const uintptr_t value = reinterpret_cast<uintptr_t>(p);
 
 #if MODM_SIZEOF_POINTER == 2
 
-	writeHex(value >> 8);
-	writeHex(value);
+	putHex(buffer, value >> 8);
+	putHex(buffer, value);
 
 #elif MODM_SIZEOF_POINTER == 4
 
 	for (uint8_t ii=24; ii < 32; ii -= 8)
-		writeHex(value >> ii);
+		putHex(buffer, value >> ii);
 
 #elif MODM_SIZEOF_POINTER == 8
 
 	for (uint8_t ii=56; ii < 64; ii -= 8)
-		writeHex(value >> ii);
+		putHex(buffer, value >> ii);
 
 #endif
 }
@@ -27,7 +27,9 @@ namespace modm
 	 *
 	 * Based on the modm::DynamicArray class, therefore grows automatically
 	 * if more space than currently allocated is needed. But because this
-	 * is an expensive operation it should be avoid if possible.
+	 * is an expensive operation it should be avoid if possible. The first
+	 * two points are stored inside the set itself, which is enough for most
+	 * intersections without allocating memory.
 	 *
 	 * \author	Fabian Greif
 	 * \ingroup	modm_math_geometry
@@ -39,6 +41,9 @@ namespace modm
 		using SizeType = std::size_t;
 		using PointType = Vector<T, 2>;
 
+	protected:
+		using Container = modm::DynamicArray< PointType, allocator::Dynamic<PointType>, 2 >;
+
 	public:
 		/**
 		 * \brief	Constructs a set capable of holding n points (default = 2)
@@ -49,9 +54,14 @@ namespace modm
 
 		PointSet2D(const PointSet2D& other);
 
+		PointSet2D(PointSet2D&& other) = default;
+
 		PointSet2D&
 		operator = (const PointSet2D& other);
 
+		PointSet2D&
+		operator = (PointSet2D&& other) = default;
+
 		/// Number of points contained in the set
 		inline SizeType
 		getNumberOfPoints() const;
@@ -73,8 +83,8 @@ namespace modm
 		removeAll();
 
 	public:
-		typedef typename modm::DynamicArray< PointType >::iterator iterator;
-		typedef typename modm::DynamicArray< PointType >::const_iterator const_iterator;
+		typedef typename Container::iterator iterator;
+		typedef typename Container::const_iterator const_iterator;
 
 		inline iterator
 		begin();
@@ -89,7 +99,7 @@ namespace modm
 		end() const;
 
 	protected:
-		modm::DynamicArray< PointType > points;
+		Container points;
 	};
 }
 
@@ -25,10 +25,33 @@
 #include <linux/can.h>
 #include <linux/can/raw.h>
 #include <string.h>
+#include <errno.h>
+#include <poll.h>
+
+#if __has_include(<modm/processing/fiber/reactor.hpp>)
+#	include <modm/processing/fiber.hpp>
+#endif
 
 #undef  MODM_LOG_LEVEL
 #define MODM_LOG_LEVEL modm::log::DEBUG
 
+namespace
+{
+
+/// Suspends the current fiber or blocks the thread until the socket is ready.
+void
+waitFor(int skt, short events)
+{
+#if __has_include(<modm/processing/fiber/reactor.hpp>)
+	modm::fiber::poll(skt, events);
+#else
+	pollfd pfd{skt, events, 0};
+	::poll(&pfd, 1, -1);
+#endif
+}
+
+}	// namespace
+
 modm::platform::SocketCan::SocketCan()
 {
 }
@@ -136,3 +159,26 @@ modm::platform::SocketCan::sendMessage(const can::Message& message)
 
 	return (bytes_sent > 0);
 }
+
+bool
+modm::platform::SocketCan::readMessage(can::Message& message)
+{
+	while (not getMessage(message))
+	{
+		if (errno != EAGAIN and errno != EWOULDBLOCK) return false;
+		waitFor(skt, POLLIN);
+	}
+	return true;
+}
+
+bool
+modm::platform::SocketCan::writeMessage(const can::Message& message)
+{
+	while (not sendMessage(message))
+	{
+		// ENOBUFS is returned when the transmit queue of the interface is full
+		if (errno != EAGAIN and errno != EWOULDBLOCK and errno != ENOBUFS) return false;
+		waitFor(skt, POLLOUT);
+	}
+	return true;
+}
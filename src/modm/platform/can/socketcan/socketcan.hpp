@@ -52,6 +52,18 @@ public:
 	bool
 	sendMessage(const can::Message& message);
 
+	/// Waits until a message was received. Suspends the current fiber if
+	/// fibers are enabled, otherwise the calling thread is blocked.
+	/// @return `false` on a socket error.
+	bool
+	readMessage(can::Message& message);
+
+	/// Waits until the message could be queued for transmission. Suspends the
+	/// current fiber if fibers are enabled, otherwise the calling thread is blocked.
+	/// @return `false` on a socket error.
+	bool
+	writeMessage(const can::Message& message);
+
 private:
 	int skt;
 };
@@ -17,6 +17,7 @@
 #include <ios>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 #include <fcntl.h>		// file control
 #include <sys/ioctl.h>	// I/O control routines
@@ -25,12 +26,34 @@
 #include <sys/socket.h>
 
 #include <errno.h>
+#include <poll.h>
 
 #include <modm/debug/logger.hpp>
+#if __has_include(<modm/processing/fiber/reactor.hpp>)
+#	include <modm/processing/fiber.hpp>
+#endif
 
 #undef MODM_LOG_LEVEL
 #define MODM_LOG_LEVEL 	modm::log::ERROR
 
+// ----------------------------------------------------------------------------
+namespace
+{
+
+/// Suspends the current fiber or blocks the thread until the port is ready.
+void
+waitFor(int fileDescriptor, short events)
+{
+#if __has_include(<modm/processing/fiber/reactor.hpp>)
+	modm::fiber::poll(fileDescriptor, events);
+#else
+	pollfd pfd{fileDescriptor, events, 0};
+	::poll(&pfd, 1, -1);
+#endif
+}
+
+}	// namespace
+
 // ----------------------------------------------------------------------------
 modm::platform::SerialInterface::SerialInterface() :
 	isConnected(false),
@@ -247,25 +270,36 @@ modm::platform::SerialInterface::read(char& c)
 }
 
 // ----------------------------------------------------------------------------
-void
+std::size_t
 modm::platform::SerialInterface::readBytes(uint8_t* data, std::size_t length)
 {
-	int delta = length;
-	int result = 0 ;
-	while (delta > 0)
+	std::size_t count = 0;
+	while (count < length)
 	{
-		result = ::read(this->fileDescriptor, (data + (length - delta)), delta);
-		if (result < 0) {
-			usleep(20);	// swap the thread, so that something could be done while waiting
-			continue;
+		const ssize_t result = ::read(this->fileDescriptor, data + count, length - count);
+		if (result > 0) {
+			count += result;
+		}
+		else if (result == 0) {
+			// end of file, the device was disconnected
+			break;
+		}
+		else if (errno == EAGAIN or errno == EWOULDBLOCK) {
+			// let other fibers or threads run while waiting for data
+			waitFor(this->fileDescriptor, POLLIN);
+		}
+		else if (errno != EINTR)
+		{
+			this->dumpErrorMessage();
+			break;
 		}
-		delta -= result;
 	}
 
-	for (std::size_t i = 0; i < length; i++) {
+	for (std::size_t i = 0; i < count; i++) {
 		MODM_LOG_DEBUG << "0x" << modm::hex << data[i] << modm::ascii << " ";
 	}
 	MODM_LOG_DEBUG << modm::endl;
+	return count;
 }
 
 // ----------------------------------------------------------------------------
@@ -275,7 +309,10 @@ modm::platform::SerialInterface::write(char c)
 /*	SUB_LOGGER_LOG(logger, Logger::ERROR, "writeByte")
 		<< "0x" << std::hex << (int)data << "; ";
  */
-	int reply = ::write(this->fileDescriptor, &c, 1);
+	int reply;
+	while ((reply = ::write(this->fileDescriptor, &c, 1)) < 0 and errno == EAGAIN) {
+		waitFor(this->fileDescriptor, POLLOUT);
+	}
 	if (reply <= 0) {
 		this->dumpErrorMessage();
 	}
@@ -287,18 +324,34 @@ modm::platform::SerialInterface::write(char c)
 void
 modm::platform::SerialInterface::write(const char* str)
 {
-	char c;
-	while ((c = *str++)) {
-		this->write(c);
-	}
+	this->writeBytes(reinterpret_cast<const uint8_t*>(str), std::strlen(str));
+}
+
+void
+modm::platform::SerialInterface::write(const char* data, std::size_t length)
+{
+	this->writeBytes(reinterpret_cast<const uint8_t*>(data), length);
 }
 
 // ----------------------------------------------------------------------------
 void
 modm::platform::SerialInterface::writeBytes(const uint8_t* data, std::size_t length)
 {
-	for (std::size_t i = 0; i < length; ++i) {
-		this->write(static_cast<char>(*data++));
+	while (length > 0)
+	{
+		const ssize_t result = ::write(this->fileDescriptor, data, length);
+		if (result < 0)
+		{
+			if (errno == EINTR) continue;
+			if (errno != EAGAIN) {
+				this->dumpErrorMessage();
+				return;
+			}
+			waitFor(this->fileDescriptor, POLLOUT);
+			continue;
+		}
+		data += result;
+		length -= result;
 	}
 }
 
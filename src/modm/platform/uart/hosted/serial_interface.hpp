@@ -138,9 +138,14 @@ namespace modm
 			/**
 			 * Read length bytes from device.
 			 *
-			 * Tries until `length` bytes are read.
+			 * Tries until `length` bytes are read. While no data is available
+			 * the current fiber is suspended if fibers are enabled, otherwise
+			 * the calling thread is blocked. Stops early at the end of file,
+			 * e.g. if the device was disconnected, or on a read error.
+			 *
+			 * @return the number of bytes read
 			 */
-			void
+			std::size_t
 			readBytes(uint8_t* data, std::size_t length);
 
 			/**
@@ -153,8 +158,14 @@ namespace modm
 			virtual void
 			write(const char* str);
 
+			/// Write a block of characters with writeBytes()
+			virtual void
+			write(const char* data, std::size_t length);
+
 			/**
 			 * Write length bytes to device.
+			 *
+			 * Waits like readBytes() while the output buffer of the device is full.
 			 */
 			void
 			writeBytes(const uint8_t* data, std::size_t length);
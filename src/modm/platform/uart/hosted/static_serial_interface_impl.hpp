@@ -99,9 +99,7 @@ modm::platform::StaticSerialInterface<N>::read(uint8_t *data, std::size_t length
 		length = available;
 	}
 
-	backend->readBytes(data, length);
-
-	return length;
+	return backend->readBytes(data, length);
 }
 
 template<int N>
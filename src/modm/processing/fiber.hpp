@@ -11,3 +11,19 @@
 
 #include "fiber/fiber.hpp"
 #include "fiber/scheduler.hpp"
+#include "fiber/waitable.hpp"
+#include "fiber/channel.hpp"
+#include "fiber/mutex.hpp"
+#include "fiber/semaphore.hpp"
+#include "fiber/condition_variable.hpp"
+#include "fiber/latch.hpp"
+#include "fiber/barrier.hpp"
+#if __has_include("fiber/pool.hpp")
+#	include "fiber/pool.hpp"
+#endif
+#if __has_include("fiber/await.hpp")
+#	include "fiber/await.hpp"
+#endif
+#if __has_include("fiber/reactor.hpp")
+#	include "fiber/reactor.hpp"
+#endif
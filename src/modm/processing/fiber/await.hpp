@@ -0,0 +1,57 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "scheduler.hpp"
+#include <modm/processing/resumable/resumable.hpp>
+
+namespace modm::fiber
+{
+
+/**
+ * Runs a resumable function to completion from inside a fiber and returns its
+ * result. The resumable function is called again after every `yield()` until
+ * it stops, so that other fibers can run while it is waiting. Since the call
+ * must be repeated, it is passed as a callable, usually a lambda:
+ *
+ * ```cpp
+ * modm::Lis302dl<Transport> sensor{data};
+ *
+ * void reader()
+ * {
+ *     modm::fiber::await([&]{ return sensor.configure(modm::lis302dl::Scale::G2); });
+ *     while (1) {
+ *         if (modm::fiber::await([&]{ return sensor.readAcceleration(); }))
+ *             MODM_LOG_INFO << data.getX() << modm::endl;
+ *     }
+ * }
+ * ```
+ *
+ * A resumable function that completes on the first call returns without
+ * yielding and nothing is allocated, the state of the resumable function is
+ * stored in its class as usual.
+ *
+ * @return the result of the resumable function, or its state for resumable
+ *         functions returning `void`, like `RF_CALL_BLOCKING()`.
+ */
+template< class Resumable >
+auto
+await(Resumable&& resumable)
+{
+	auto result = resumable();
+	while (result.getState() > rf::NestingError)
+	{
+		yield();
+		result = resumable();
+	}
+	return result.getResult();
+}
+
+}	// namespace modm::fiber
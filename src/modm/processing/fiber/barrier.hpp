@@ -0,0 +1,71 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "waitable.hpp"
+
+namespace modm::fiber
+{
+
+/**
+ * Reusable barrier that suspends fibers until the expected number of fibers
+ * have arrived, then resumes them all and starts the next phase.
+ *
+ * @ingroup	modm_processing_fiber
+ */
+class Barrier : Waitable
+{
+public:
+	constexpr explicit
+	Barrier(uint16_t expected) :
+		expected(expected), count(expected)
+	{}
+
+	/// Arrives at the barrier and suspends the current fiber until the
+	/// current phase completes.
+	void
+	arrive_and_wait()
+	{
+		uint16_t arrival_phase;
+		{
+			[[maybe_unused]] Lock lock;
+			arrival_phase = phase;
+			if (arrive()) return;
+		}
+		waitUntil([&]() { return phase != arrival_phase; });
+	}
+
+	/// Arrives at the barrier and decrements the expected count of all
+	/// following phases without waiting.
+	void
+	arrive_and_drop()
+	{
+		[[maybe_unused]] Lock lock;
+		expected--;
+		arrive();
+	}
+
+private:
+	bool
+	arrive()
+	{
+		if (--count) return false;
+		count = expected;
+		phase++;
+		while(resumeFirst()) ;
+		return true;
+	}
+
+	uint16_t expected;
+	uint16_t count;
+	uint16_t phase{0};
+};
+
+}	// namespace modm::fiber
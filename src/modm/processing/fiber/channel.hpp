@@ -0,0 +1,138 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "waitable.hpp"
+
+namespace modm::fiber
+{
+
+/**
+ * Bounded FIFO channel for passing data between fibers.
+ *
+ * The data is stored inside the channel in a statically sized ring buffer.
+ * A fiber sending into a full channel or receiving from an empty channel is
+ * suspended until the opposite side makes progress, instead of spinning on
+ * `yield()`. Every successful operation wakes up exactly one waiter and the
+ * channel may be shared between fibers running on different cores.
+ *
+ * ```cpp
+ * modm::fiber::Channel<uint8_t, 16> channel;
+ *
+ * void producer() { for (uint8_t ii=0; ; ii++) channel.send(ii); }
+ * void consumer() { while(1) MODM_LOG_INFO << channel.receive() << modm::endl; }
+ * ```
+ *
+ * @tparam	Data_t	type of the transported data, must be default constructible.
+ * @tparam	Size	maximum number of elements stored in the channel.
+ *
+ * @ingroup	modm_processing_fiber
+ */
+template<class Data_t, size_t Size>
+class Channel
+{
+	static_assert(Size > 0, "Channel must have a capacity of at least one element!");
+
+public:
+	constexpr Channel() = default;
+	Channel(const Channel&) = delete;
+	Channel& operator=(const Channel&) = delete;
+
+	bool
+	empty() const
+	{ return count == 0; }
+
+	bool
+	full() const
+	{ return count >= Size; }
+
+	size_t
+	size() const
+	{ return count; }
+
+	static constexpr size_t
+	capacity()
+	{ return Size; }
+
+	/// Appends the data to the channel without blocking.
+	/// @return `false` if the channel is full.
+	bool
+	trySend(const Data_t& data)
+	{
+		[[maybe_unused]] typename Queue::Lock lock;
+		return push(data);
+	}
+
+	/// Removes the oldest data from the channel without blocking.
+	/// @return `false` if the channel is empty.
+	bool
+	tryReceive(Data_t& data)
+	{
+		[[maybe_unused]] typename Queue::Lock lock;
+		return pop(data);
+	}
+
+	/// Suspends the current fiber until there is space in the channel.
+	void
+	send(const Data_t& data)
+	{
+		bool done{false};
+		while (not done) senders.waitUntil([&]() { return done = push(data); });
+	}
+
+	/// Suspends the current fiber until data is available in the channel.
+	Data_t
+	receive()
+	{
+		Data_t data;
+		bool done{false};
+		while (not done) receivers.waitUntil([&]() { return done = pop(data); });
+		return data;
+	}
+
+private:
+	bool
+	push(const Data_t& data)
+	{
+		if (full()) return false;
+		buffer[tail] = data;
+		if (++tail >= Size) tail = 0;
+		count++;
+		receivers.resumeFirst();
+		return true;
+	}
+
+	bool
+	pop(Data_t& data)
+	{
+		if (empty()) return false;
+		data = buffer[head];
+		if (++head >= Size) head = 0;
+		count--;
+		senders.resumeFirst();
+		return true;
+	}
+
+	struct Queue : Waitable
+	{
+		using Waitable::Lock;
+		using Waitable::resumeFirst;
+		using Waitable::waitUntil;
+	};
+
+	Data_t buffer[Size]{};
+	size_t head{0};
+	size_t tail{0};
+	size_t count{0};
+	Queue senders;
+	Queue receivers;
+};
+
+}	// namespace modm::fiber
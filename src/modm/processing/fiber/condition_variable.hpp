@@ -0,0 +1,70 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "mutex.hpp"
+
+namespace modm::fiber
+{
+
+/**
+ * Condition variable for fibers.
+ *
+ * `wait()` atomically unlocks the mutex and suspends the current fiber until
+ * it is notified, then locks the mutex again before returning. Notified fibers
+ * are resumed in FIFO order.
+ *
+ * @warning `wait(mutex)` may return spuriously, use the predicate overload or
+ *          check the condition in a loop.
+ *
+ * @ingroup	modm_processing_fiber
+ */
+class ConditionVariable : Waitable
+{
+public:
+	constexpr ConditionVariable() = default;
+
+	using Waitable::hasWaiters;
+
+	void
+	wait(Mutex& mutex)
+	{
+		bool suspended;
+		{
+			[[maybe_unused]] Lock lock;
+			if ((suspended = canSuspend())) suspendCurrent();
+			mutex.release();
+		}
+		if (suspended) jumpNext();
+		else yield();
+		mutex.lock();
+	}
+
+	template< class Predicate >
+	void
+	wait(Mutex& mutex, Predicate&& predicate)
+	{
+		while (not predicate()) wait(mutex);
+	}
+
+	void
+	notify_one()
+	{
+		signal();
+	}
+
+	void
+	notify_all()
+	{
+		signalAll();
+	}
+};
+
+}	// namespace modm::fiber
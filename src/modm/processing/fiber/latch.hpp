@@ -0,0 +1,64 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "waitable.hpp"
+
+namespace modm::fiber
+{
+
+/**
+ * Single-use downward counter that suspends fibers until it reaches zero.
+ *
+ * @ingroup	modm_processing_fiber
+ */
+class Latch : Waitable
+{
+public:
+	constexpr explicit
+	Latch(uint16_t expected) :
+		count(expected)
+	{}
+
+	/// Decrements the counter and resumes all waiting fibers when it reaches zero.
+	void
+	count_down(uint16_t update = 1)
+	{
+		[[maybe_unused]] Lock lock;
+		if (count == 0) return;
+		count = (update < count) ? count - update : 0;
+		if (count == 0) while(resumeFirst()) ;
+	}
+
+	bool
+	try_wait() const
+	{
+		return count == 0;
+	}
+
+	/// Suspends the current fiber until the counter reaches zero.
+	void
+	wait()
+	{
+		waitUntil([this]() { return count == 0; });
+	}
+
+	void
+	arrive_and_wait(uint16_t update = 1)
+	{
+		count_down(update);
+		wait();
+	}
+
+private:
+	uint16_t count;
+};
+
+}	// namespace modm::fiber
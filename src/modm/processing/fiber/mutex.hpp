@@ -0,0 +1,74 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "waitable.hpp"
+
+namespace modm::fiber
+{
+
+/**
+ * Mutual exclusion between fibers.
+ *
+ * A fiber trying to lock a locked mutex is suspended until the mutex is
+ * unlocked. The ownership is handed over directly to the longest waiting fiber
+ * on unlock, so that waiters cannot starve. The mutex is not recursive.
+ *
+ * The interface is compatible with `std::lock_guard` and `std::unique_lock`.
+ *
+ * @ingroup	modm_processing_fiber
+ */
+class Mutex : Waitable
+{
+	friend class ConditionVariable;
+
+public:
+	constexpr Mutex() = default;
+
+	void
+	lock()
+	{
+		waitUntil([this]() { return acquire(); });
+	}
+
+	bool
+	try_lock()
+	{
+		[[maybe_unused]] Lock lock;
+		return acquire();
+	}
+
+	void
+	unlock()
+	{
+		[[maybe_unused]] Lock lock;
+		release();
+	}
+
+private:
+	bool
+	acquire()
+	{
+		if (locked) return false;
+		locked = true;
+		return true;
+	}
+
+	void
+	release()
+	{
+		// the first waiter now owns the mutex, so it stays locked
+		if (not resumeFirst()) locked = false;
+	}
+
+	bool locked{false};
+};
+
+}	// namespace modm::fiber
@@ -0,0 +1,105 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "scheduler.hpp"
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+
+namespace modm::fiber
+{
+
+/**
+ * Suspends the current fiber until the file descriptor is ready for any of
+ * the `EPOLLIN`, `EPOLLOUT` or `EPOLLPRI` events. The file descriptor is
+ * registered with the epoll instance of the scheduler until it becomes ready,
+ * so a waiting fiber does not cost any context switches and the scheduler
+ * blocks in the kernel if no other fiber is ready.
+ *
+ * Only one fiber can wait for a file descriptor at a time. For additional
+ * waiters, for regular files, which cannot be used with epoll, and outside of
+ * a fiber, this function falls back to `::poll()` in a `yield()` loop.
+ *
+ * @return the ready events, which may also contain `EPOLLERR` and `EPOLLHUP`.
+ */
+inline uint32_t
+poll(int fd, uint32_t events)
+{
+	auto& d = Scheduler::getData();
+	const bool in_fiber = d.current != nullptr;
+	if (in_fiber)
+	{
+		d.openReactor();
+		Scheduler::Poller poller{d.current, fd, events};
+		epoll_event event{};
+		event.events = events;
+		event.data.ptr = &poller;
+		if (epoll_ctl(d.epoll, EPOLL_CTL_ADD, fd, &event) == 0)
+		{
+			d.polling++;
+			d.removeCurrent();
+			d.jumpNext();
+			return poller.events;
+		}
+	}
+	// The poll and epoll event flags have the same values
+	pollfd pfd{fd, short(events), 0};
+	while (::poll(&pfd, 1, in_fiber ? 0 : -1) <= 0) yield();
+	return uint16_t(pfd.revents);
+}
+
+/// Suspends the current fiber until the file descriptor is readable.
+inline void
+wait_readable(int fd)
+{
+	poll(fd, EPOLLIN);
+}
+
+/// Suspends the current fiber until the file descriptor is writable.
+inline void
+wait_writable(int fd)
+{
+	poll(fd, EPOLLOUT);
+}
+
+/**
+ * Reads up to `size` bytes from a non-blocking file descriptor and suspends
+ * the current fiber while no data is available.
+ *
+ * @return the number of bytes read, 0 at the end of the file or -1 on error.
+ */
+inline ssize_t
+read(int fd, void* buffer, size_t size)
+{
+	ssize_t result;
+	while ((result = ::read(fd, buffer, size)) < 0 and
+		   (errno == EAGAIN or errno == EWOULDBLOCK))
+		wait_readable(fd);
+	return result;
+}
+
+/**
+ * Writes up to `size` bytes to a non-blocking file descriptor and suspends
+ * the current fiber while the file descriptor is not writable.
+ *
+ * @return the number of bytes written or -1 on error.
+ */
+inline ssize_t
+write(int fd, const void* buffer, size_t size)
+{
+	ssize_t result;
+	while ((result = ::write(fd, buffer, size)) < 0 and
+		   (errno == EAGAIN or errno == EWOULDBLOCK))
+		wait_writable(fd);
+	return result;
+}
+
+}	// namespace modm::fiber
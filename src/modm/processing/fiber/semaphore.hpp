@@ -0,0 +1,75 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include "waitable.hpp"
+
+namespace modm::fiber
+{
+
+/**
+ * Counting semaphore for fibers.
+ *
+ * A fiber acquiring a semaphore with a count of zero is suspended until
+ * another fiber releases the semaphore. A release hands the count over
+ * directly to the longest waiting fiber, so that waiters cannot starve.
+ *
+ * @ingroup	modm_processing_fiber
+ */
+class Semaphore : Waitable
+{
+public:
+	constexpr explicit
+	Semaphore(uint16_t initial) :
+		count(initial)
+	{}
+
+	void
+	acquire()
+	{
+		waitUntil([this]() { return take(); });
+	}
+
+	bool
+	try_acquire()
+	{
+		[[maybe_unused]] Lock lock;
+		return take();
+	}
+
+	void
+	release(uint16_t update = 1)
+	{
+		[[maybe_unused]] Lock lock;
+		for (; update; update--)
+		{
+			if (not resumeFirst()) count++;
+		}
+	}
+
+	uint16_t
+	available() const
+	{
+		return count;
+	}
+
+private:
+	bool
+	take()
+	{
+		if (count == 0) return false;
+		count--;
+		return true;
+	}
+
+	uint16_t count;
+};
+
+}	// namespace modm::fiber
@@ -0,0 +1,119 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace modm::rtos
+{
+
+/**
+ * Bounded multi-producer multi-consumer queue without mutexes.
+ *
+ * Every cell of the ring buffer carries a sequence number, which tells the
+ * producers and consumers whether the cell is free or filled in the current
+ * lap around the ring. Producers and consumers claim a position with a single
+ * compare-and-swap on their own index and then publish the cell by writing its
+ * sequence number. Both indices are 64-bit and never wrap around in practice,
+ * so that the capacity does not need to be a power of two and may be as small
+ * as one element.
+ *
+ * `peek()` marks the cell as busy while it copies the element, and `pop()`
+ * marks it the same way while it moves the element out, so that a consumer
+ * only waits for another consumer copying the same element.
+ *
+ * @warning The queue is *not* lock-free: A thread that is preempted after it
+ *          claimed a cell and before it published it, stalls the other
+ *          threads that need the same cell. A producer that has not yet
+ *          published its element lets `pop()` report an empty queue, even if
+ *          later cells are filled already, and `peek()` as well as `pop()`
+ *          spin while another consumer holds the busy cell.
+ *
+ * `push()` and `pop()` fail instead of blocking if the queue is full or empty.
+ * Use `modm::rtos::Queue` for blocking with a timeout.
+ *
+ * @tparam	T	copyable element type.
+ *
+ * @ingroup	modm_processing_rtos
+ */
+template< typename T >
+class MpmcQueue
+{
+public:
+	/// @param capacity the maximum number of elements, at least one.
+	explicit
+	MpmcQueue(std::size_t capacity);
+
+	~MpmcQueue();
+
+	MpmcQueue(const MpmcQueue&) = delete;
+	MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+	/// @return `false` if the queue is full.
+	bool
+	push(const T& item);
+
+	/// Moves the oldest element into `item`.
+	/// @return `false` if the queue is empty.
+	bool
+	pop(T& item);
+
+	/// Copies the oldest element into `item` without removing it.
+	/// A concurrent `pop()` of the element waits until it is copied.
+	/// @return `false` if the queue is empty.
+	bool
+	peek(T& item) const;
+
+	/// @return the number of stored elements, which is only a snapshot if
+	///         other threads access the queue concurrently.
+	std::size_t
+	getSize() const;
+
+	std::size_t
+	getMaxSize() const
+	{ return capacity; }
+
+	bool
+	isEmpty() const
+	{ return getSize() == 0; }
+
+	bool
+	isFull() const
+	{ return getSize() == capacity; }
+
+private:
+	struct Cell
+	{
+		std::atomic<uint64_t> sequence;
+		alignas(T) std::byte storage[sizeof(T)];
+
+		T*
+		item()
+		{ return std::launder(reinterpret_cast<T*>(storage)); }
+	};
+
+	/// Set in the sequence of a cell while its element is copied or removed
+	static constexpr uint64_t Busy = uint64_t(1) << 63;
+
+	const std::size_t capacity;
+	const std::unique_ptr<Cell[]> cells;
+
+	/// Claimed by the producers
+	alignas(64) std::atomic<uint64_t> enqueuePosition{0};
+	/// Claimed by the consumers
+	alignas(64) std::atomic<uint64_t> dequeuePosition{0};
+};
+
+}	// namespace modm::rtos
+
+#include "mpmc_queue_impl.hpp"
@@ -0,0 +1,137 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template< typename T >
+modm::rtos::MpmcQueue<T>::MpmcQueue(std::size_t capacity) :
+	capacity(capacity ? capacity : 1), cells(new Cell[this->capacity])
+{
+	// A cell at position p is free for the producer, if its sequence is 2p,
+	// and filled for the consumer, if its sequence is 2p + 1. Doubling the
+	// position keeps both states distinct even with a capacity of one.
+	// While a consumer copies or removes the item, the Busy bit is set.
+	for (std::size_t ii = 0; ii < this->capacity; ii++)
+		cells[ii].sequence.store(2 * ii, std::memory_order_relaxed);
+}
+
+template< typename T >
+modm::rtos::MpmcQueue<T>::~MpmcQueue()
+{
+	if constexpr (not std::is_trivially_destructible_v<T>)
+	{
+		const uint64_t end = enqueuePosition.load(std::memory_order_relaxed);
+		for (uint64_t pos = dequeuePosition.load(std::memory_order_relaxed); pos != end; pos++)
+			cells[pos % capacity].item()->~T();
+	}
+}
+
+// ----------------------------------------------------------------------------
+template< typename T >
+bool
+modm::rtos::MpmcQueue<T>::push(const T& item)
+{
+	uint64_t pos = enqueuePosition.load(std::memory_order_relaxed);
+	Cell* cell;
+	while (true)
+	{
+		cell = &cells[pos % capacity];
+		const uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+		const int64_t diff = int64_t(sequence - 2 * pos);
+		if (diff == 0)
+		{
+			// the cell is free, try to claim the position
+			if (enqueuePosition.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		}
+		// the consumer has not yet freed the cell of the last lap
+		else if (diff < 0) return false;
+		// another producer claimed the position
+		else pos = enqueuePosition.load(std::memory_order_relaxed);
+	}
+	new (cell->storage) T(item);
+	cell->sequence.store(2 * pos + 1, std::memory_order_release);
+	return true;
+}
+
+template< typename T >
+bool
+modm::rtos::MpmcQueue<T>::pop(T& item)
+{
+	uint64_t pos = dequeuePosition.load(std::memory_order_relaxed);
+	Cell* cell;
+	while (true)
+	{
+		cell = &cells[pos % capacity];
+		// a cell that is being peeked at is still filled
+		const uint64_t sequence = cell->sequence.load(std::memory_order_acquire) & ~Busy;
+		const int64_t diff = int64_t(sequence - (2 * pos + 1));
+		if (diff == 0)
+		{
+			// the cell is filled, try to claim the position
+			if (dequeuePosition.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		}
+		// the producer has not yet filled the cell
+		else if (diff < 0) return false;
+		// another consumer claimed the position
+		else pos = dequeuePosition.load(std::memory_order_relaxed);
+	}
+	// wait for peek() to finish copying the item before moving it out
+	uint64_t sequence = 2 * pos + 1;
+	while (not cell->sequence.compare_exchange_weak(sequence, sequence | Busy,
+			std::memory_order_acquire, std::memory_order_relaxed))
+	{
+		sequence = 2 * pos + 1;
+	}
+	T* stored = cell->item();
+	item = std::move(*stored);
+	stored->~T();
+	// free the cell for the producer of the next lap
+	cell->sequence.store(2 * (pos + capacity), std::memory_order_release);
+	return true;
+}
+
+template< typename T >
+bool
+modm::rtos::MpmcQueue<T>::peek(T& item) const
+{
+	while (true)
+	{
+		const uint64_t pos = dequeuePosition.load(std::memory_order_relaxed);
+		Cell& cell = cells[pos % capacity];
+		uint64_t sequence = 2 * pos + 1;
+		// claim the cell, so that no consumer can remove the item while it is copied
+		if (cell.sequence.compare_exchange_weak(sequence, sequence | Busy,
+				std::memory_order_acquire, std::memory_order_relaxed))
+		{
+			item = *cell.item();
+			cell.sequence.store(2 * pos + 1, std::memory_order_release);
+			return true;
+		}
+		// another thread is copying or removing the item, or the CAS failed spuriously
+		if (sequence & Busy or sequence == 2 * pos + 1) continue;
+		// the producer has not yet filled the cell
+		if (int64_t(sequence - (2 * pos + 1)) < 0) return false;
+		// otherwise a consumer removed the item in the meantime
+	}
+}
+
+template< typename T >
+std::size_t
+modm::rtos::MpmcQueue<T>::getSize() const
+{
+	// read the consumer index first, so that the size is never negative
+	const uint64_t dequeue = dequeuePosition.load(std::memory_order_acquire);
+	const uint64_t enqueue = enqueuePosition.load(std::memory_order_acquire);
+	const uint64_t size = enqueue - dequeue;
+	return size < capacity ? size : capacity;
+}
@@ -14,10 +14,13 @@
 #define MODM_STDLIB_QUEUE_HPP
 
 #include <stdint.h>
+#include <atomic>
+#include <condition_variable>
 #include <deque>
-
 #include <mutex>
 
+#include "mpmc_queue.hpp"
+
 namespace modm
 {
 	namespace rtos
@@ -25,6 +28,23 @@ namespace modm
 		/**
 		 * Thread-safe Queue.
 		 *
+		 * The items are stored in an `MpmcQueue`, so appending to a queue
+		 * that is not full and getting from a queue that is not empty does
+		 * not take a mutex. Threads that have to wait for space or an item
+		 * first yield a few times and then sleep on a condition variable,
+		 * which is notified only if a thread is actually waiting. Every
+		 * removed item wakes up only one waiting producer.
+		 *
+		 * The ring buffer only supports FIFO order, so `prepend()` stores
+		 * the item in a separate list protected by a mutex. This is a slow
+		 * path: While prepended items are stored, all operations take this
+		 * mutex. An `append()` racing with a `prepend()` may still use the
+		 * last free element of the ring buffer, so that the queue briefly
+		 * contains more items than its length.
+		 *
+		 * The timeout is given in milliseconds. A timeout of zero never blocks
+		 * and the default timeout of `uint32_t(-1)` blocks indefinitely.
+		 *
 		 * \ingroup	modm_processing_rtos
 		 */
 		template<typename T>
@@ -50,10 +70,10 @@ namespace modm
 			bool
 			append(const T& item, uint32_t timeout = -1);
 
+			/// Inserts the item in front of all other items.
 			bool
 			prepend(const T& item, uint32_t timeout = -1);
 
-
 			bool
 			peek(T& item, uint32_t timeout = -1) const;
 
@@ -78,12 +98,52 @@ namespace modm
 			Queue&
 			operator = (const Queue& other);
 
-			mutable std::timed_mutex mutex;
+			struct Waiters
+			{
+				std::condition_variable condition;
+				std::atomic<uint32_t> count{0};
+			};
+
+			/// Retries the operation until it succeeds or the timeout expires.
+			template<typename Operation>
+			bool
+			wait(Waiters& waiters, uint32_t timeout, Operation&& operation) const;
+
+			/// Wakes up waiting threads after an item was added or removed.
+			void
+			notify(Waiters& waiters, bool all) const;
+
+			/// Appends the item to the ring buffer, if the queue is not full.
+			bool
+			push(const T& item);
+
+			/// Inserts the item into the prepended items, if the queue is not full.
+			bool
+			pushFront(const T& item);
+
+			/// Removes the first prepended item or the oldest item of the ring buffer.
+			bool
+			pop(T& item);
 
-			uint32_t maxSize;
-			std::deque<T> deque;
+			/// Copies the first prepended item or the oldest item of the ring buffer.
+			bool
+			peekFront(T& item) const;
+
+			MpmcQueue<T> queue;
+
+			// The prepended items are only accessed with the front mutex held
+			mutable std::mutex frontMutex;
+			std::deque<T> front;
+			std::atomic<uint32_t> frontSize{0};
+
+			// The mutex and conditions are only used by waiting threads
+			mutable std::mutex mutex;
+			mutable Waiters producers;
+			mutable Waiters consumers;
 		};
 	}
 }
 
+#include "queue_impl.hpp"
+
 #endif // MODM_STDLIB_QUEUE_HPP
@@ -16,10 +16,11 @@
 #endif
 
 #include <chrono>
+#include <thread>
 
 template <typename T>
 modm::rtos::Queue<T>::Queue(uint32_t length) :
-	maxSize(length)
+	queue(length)
 {
 }
 
@@ -32,80 +33,161 @@ template <typename T>
 std::size_t
 modm::rtos::Queue<T>::getSize() const
 {
-	std::lock_guard<std::timed_mutex> lock(mutex);
-	deque.size();
+	return queue.getSize() + frontSize.load(std::memory_order_relaxed);
 }
 
 template <typename T>
 bool
-modm::rtos::Queue<T>::append(const T& item, uint32_t timeout = -1)
+modm::rtos::Queue<T>::append(const T& item, uint32_t timeout)
 {
-	if (!mutex.try_lock_for(std::chrono::milliseconds(timeout)) ||
-			deque.size() >= maxSize) {
-		return false;
+	if (push(item) or wait(producers, timeout, [&] { return push(item); }))
+	{
+		// a waiting peek() does not remove the item, so wake up all consumers
+		notify(consumers, true);
+		return true;
 	}
-
-	deque.push_back(item);
-	mutex.unlock();
+	return false;
 }
 
 template <typename T>
 bool
-modm::rtos::Queue<T>::prepend(const T& item, uint32_t timeout = -1)
+modm::rtos::Queue<T>::prepend(const T& item, uint32_t timeout)
 {
-	if (!mutex.try_lock_for(std::chrono::milliseconds(timeout))) {
-		return false;
+	if (pushFront(item) or wait(producers, timeout, [&] { return pushFront(item); }))
+	{
+		notify(consumers, true);
+		return true;
 	}
-
-	if (deque.empty()) {
-		mutex.unlock();
-		return false;
-	}
-
-	deque.push_front(item);
-	mutex.unlock();
-
 	return false;
 }
 
 // ----------------------------------------------------------------------------
 template <typename T>
 bool
-modm::rtos::Queue<T>::peek(T& item, uint32_t timeout = -1) const
+modm::rtos::Queue<T>::peek(T& item, uint32_t timeout) const
 {
-	if (!mutex.try_lock_for(std::chrono::milliseconds(timeout))) {
-		return false;
-	}
+	return peekFront(item) or wait(consumers, timeout, [&] { return peekFront(item); });
+}
 
-	if (deque.empty()) {
-		mutex.unlock();
-		return false;
+template <typename T>
+bool
+modm::rtos::Queue<T>::get(T& item, uint32_t timeout)
+{
+	if (pop(item) or wait(consumers, timeout, [&] { return pop(item); }))
+	{
+		notify(producers, false);
+		return true;
 	}
+	return false;
+}
+
+// ----------------------------------------------------------------------------
+template <typename T>
+bool
+modm::rtos::Queue<T>::push(const T& item)
+{
+	if (frontSize.load(std::memory_order_acquire) == 0) return queue.push(item);
 
-	item = deque.front();
+	// the prepended items count towards the length of the queue
+	std::lock_guard<std::mutex> lock(frontMutex);
+	if (queue.getSize() + front.size() >= queue.getMaxSize()) return false;
+	return queue.push(item);
+}
 
-	mutex.unlock();
+template <typename T>
+bool
+modm::rtos::Queue<T>::pushFront(const T& item)
+{
+	std::lock_guard<std::mutex> lock(frontMutex);
+	if (queue.getSize() + front.size() >= queue.getMaxSize()) return false;
+	front.push_front(item);
+	frontSize.store(front.size(), std::memory_order_release);
 	return true;
 }
 
 template <typename T>
 bool
-modm::rtos::Queue<T>::get(T& item, uint32_t timeout = -1)
+modm::rtos::Queue<T>::pop(T& item)
 {
-	if (!mutex.try_lock_for(std::chrono::milliseconds(timeout))) {
-		return false;
+	if (frontSize.load(std::memory_order_acquire))
+	{
+		std::lock_guard<std::mutex> lock(frontMutex);
+		if (not front.empty())
+		{
+			item = std::move(front.front());
+			front.pop_front();
+			frontSize.store(front.size(), std::memory_order_release);
+			return true;
+		}
 	}
+	return queue.pop(item);
+}
 
-	if (deque.empty()) {
-		mutex.unlock();
-		return false;
+template <typename T>
+bool
+modm::rtos::Queue<T>::peekFront(T& item) const
+{
+	if (frontSize.load(std::memory_order_acquire))
+	{
+		std::lock_guard<std::mutex> lock(frontMutex);
+		if (not front.empty())
+		{
+			item = front.front();
+			return true;
+		}
 	}
+	return queue.peek(item);
+}
 
-	item = deque.front();
-	deque.pop_front();
+// ----------------------------------------------------------------------------
+template <typename T>
+template <typename Operation>
+bool
+modm::rtos::Queue<T>::wait(Waiters& waiters, uint32_t timeout, Operation&& operation) const
+{
+	if (timeout == 0) return false;
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+	// Give other threads a chance to change the queue before going to sleep,
+	// which is much cheaper than being woken up by the condition variable.
+	for (uint8_t retry = 0; retry < 16; retry++)
+	{
+		std::this_thread::yield();
+		if (operation()) return true;
+	}
 
-	mutex.unlock();
-	return true;
+	std::unique_lock<std::mutex> lock(mutex);
+	// Announce the waiting thread before retrying, so that a thread that
+	// changes the queue in between either sees it or the retry succeeds.
+	waiters.count.fetch_add(1);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	bool success;
+	while (not (success = operation()))
+	{
+		if (timeout == uint32_t(-1)) {
+			waiters.condition.wait(lock);
+		}
+		else if (waiters.condition.wait_until(lock, deadline) == std::cv_status::timeout) {
+			success = operation();
+			break;
+		}
+	}
+	waiters.count.fetch_sub(1);
+	return success;
+}
+
+template <typename T>
+void
+modm::rtos::Queue<T>::notify(Waiters& waiters, bool all) const
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (waiters.count.load(std::memory_order_relaxed))
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (all) waiters.condition.notify_all();
+		else waiters.condition.notify_one();
+	}
 }
 
 // ----------------------------------------------------------------------------
@@ -113,19 +195,19 @@ template <typename T>
 inline bool
 modm::rtos::Queue<T>::appendFromInterrupt(const T& item)
 {
-	return append(item);
+	return append(item, 0);
 }
 
 template <typename T>
 inline bool
 modm::rtos::Queue<T>::prependFromInterrupt(const T& item)
 {
-	return prepend(item);
+	return prepend(item, 0);
 }
 
 template <typename T>
 inline bool
 modm::rtos::Queue<T>::getFromInterrupt(T& item)
 {
-	return get(item);
+	return get(item, 0);
 }
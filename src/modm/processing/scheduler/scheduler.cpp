@@ -14,7 +14,7 @@
 
 // ----------------------------------------------------------------------------
 modm::Scheduler::Scheduler() :
-	taskList(0), readyList(0), currentPriority(0)
+	wheel(), readyList(), readyMask(0), ticks(0), currentPriority(0)
 {
 }
 
@@ -24,23 +24,84 @@ modm::Scheduler::scheduleTask(Task& task,
 		uint16_t period,
 		Priority priority)
 {
+	if (period == 0) {
+		period = 1;
+	}
 	TaskListItem *item = new TaskListItem(task, period, priority);
 
-	if (taskList == 0) {
-		taskList = item;
-	}
-	else {
-		item->nextTask = taskList;
-		taskList = item;
-	}
+	atomic::Lock lock;
+	item->time = ticks + period;
+	insertTask(item);
 }
 
 // ----------------------------------------------------------------------------
-/*bool
+bool
 modm::Scheduler::removeTask(const Task& task)
 {
+	atomic::Lock lock;
+
+	for (auto& level : wheel)
+	{
+		for (TaskListItem *slot : level)
+		{
+			for (TaskListItem *item = slot; item != 0; item = item->nextTask)
+			{
+				if (&item->task != &task) {
+					continue;
+				}
+
+				unlinkTask(item);
+				if (item->state & TaskListItem::READY) {
+					removeReady(item);
+				}
+				if (item->state & TaskListItem::RUNNING) {
+					// deleted by scheduleInterupt() after the task returned
+					item->state |= TaskListItem::REMOVED;
+				}
+				else {
+					delete item;
+				}
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+// ----------------------------------------------------------------------------
+void
+modm::Scheduler::cascade(uint8_t level)
+{
+	TaskListItem **slot = &wheel[level][(ticks >> (wheelBits * level)) % wheelSlots];
+	TaskListItem *item = *slot;
+	*slot = 0;
+
+	// the tasks are due within the period of this slot, so they are moved
+	// to a finer level
+	while (item != 0)
+	{
+		TaskListItem *next = item->nextTask;
+		insertTask(item);
+		item = next;
+	}
+}
+
+void
+modm::Scheduler::removeReady(TaskListItem *item)
+{
+	const uint8_t bucket = item->priority / (256 / readyBuckets);
+
+	TaskListItem **node = &readyList[bucket];
+	while (*node != item) {
+		node = &(*node)->nextReady;
+	}
+	*node = item->nextReady;
+
+	if (readyList[bucket] == 0) {
+		readyMask &= ~(uint32_t(1) << bucket);
+	}
+	item->state &= ~TaskListItem::READY;
 }
-*/
 
 // ----------------------------------------------------------------------------
 void
@@ -32,6 +32,13 @@ namespace modm
 	 * with the highest priority is executed. It will only change tasks if a
 	 * task with a higher priority becomes ready or the current task ends.
 	 *
+	 * The tasks are sorted into a hierarchical timing wheel by the tick at
+	 * which they become ready next, so that a call to schedule() only has to
+	 * look at the tasks that are due. Every task is moved to a finer level of
+	 * the wheel at most three times per period. Ready tasks are kept in 32
+	 * priority buckets with a bitmap of the non-empty buckets, so that the
+	 * task with the highest priority is found in constant time.
+	 *
 	 * \warning	Works for ATmega, but currently not for the ATxmega!
 	 *
 	 * \author	Fabian Greif
@@ -55,14 +62,27 @@ namespace modm
 	public:
 		Scheduler();
 
+		/**
+		 * \brief	Add a task that is run every `period` calls of schedule()
+		 *
+		 * A period of zero is treated as a period of one. Tasks with a
+		 * priority of zero are never run.
+		 */
 		void
 		scheduleTask(Task& task,
 					 uint16_t period,
 					 Priority priority = 127);
 
-		// TODO	Implement this function
-		/*bool
-		removeTask(const Task& task);*/
+		/**
+		 * \brief	Remove a task from the scheduler
+		 *
+		 * May also be called by the task itself from its run() function.
+		 *
+		 * \return	`true` if the task was removed, `false` if it was not
+		 * 			scheduled.
+		 */
+		bool
+		removeTask(const Task& task);
 
 		void
 		schedule();
@@ -76,31 +96,62 @@ namespace modm
 			TaskListItem(Task& task,
 						 uint16_t period,
 						 Priority priority) :
-				nextTask(0), nextReady(0), task(task),
-				period(period), time(period), priority(priority),
-				state(WAITING)
+				nextTask(0), previousTask(0), nextReady(0), task(task),
+				period(period), time(0), priority(priority),
+				state(0)
 			{
 			}
 
 			TaskListItem *nextTask;
+			/// Pointer that points to this item in its slot of the wheel
+			TaskListItem **previousTask;
 			TaskListItem *nextReady;
 
 			Task& task;
 			uint16_t period;
+			/// Tick at which the task becomes ready next
 			uint16_t time;
 			Priority priority;
 			/// @cond
 			enum {
-				RUNNING,
-				READY,
-				WAITING
-			} state;
+				READY = 0x01,
+				RUNNING = 0x02,
+				REMOVED = 0x04,
+			};
+			uint8_t state;
 			/// @endcond
 		};
 
-		TaskListItem *taskList;
-		TaskListItem *readyList;
+		/// Number of tick bits covered by each level of the timing wheel
+		static constexpr uint8_t wheelBits = 4;
+		static constexpr uint8_t wheelSlots = 1 << wheelBits;
+		/// Number of levels, which together cover all 16-bit periods
+		static constexpr uint8_t wheelLevels = 4;
+		/// Number of priority buckets of the ready list
+		static constexpr uint8_t readyBuckets = 32;
+
+		void
+		insertTask(TaskListItem *item);
+
+		static void
+		unlinkTask(TaskListItem *item);
+
+		void
+		cascade(uint8_t level);
+
+		void
+		addReady(TaskListItem *item);
+
+		void
+		removeReady(TaskListItem *item);
+
+		TaskListItem *wheel[wheelLevels][wheelSlots];
+		/// Ready tasks of each bucket, sorted by priority
+		TaskListItem *readyList[readyBuckets];
+		/// Bitmap of the non-empty ready buckets
+		uint32_t readyMask;
 
+		uint16_t ticks;
 		Priority currentPriority;
 	};
 }
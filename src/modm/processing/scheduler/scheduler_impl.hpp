@@ -16,18 +16,22 @@
 	#error	"Don't include this file directly, use 'scheduler.hpp' instead!"
 #endif
 
-/* item is element of two lists (schedule list and ready list).
- * ready list is order by its priority.
+#include <bit>
+
+/* item is element of the timing wheel and, while it is ready, of the ready
+ * list of its priority bucket, which is ordered by priority.
  *
  * ALGORITHM:
  * ----------------------------------------------------------------------------
- * foreach item
- *     decrement
- *     if time = 0
- *         reload time
- *         set as ready
+ * increment ticks
+ * foreach coarser level whose slot is due
+ *     move items to the finer levels
+ *
+ * foreach item in the current slot of the finest level
+ *     reload time and reinsert into the wheel
+ *     set as ready
  *
- * foreach item is ready (ordered by priority)
+ * while the highest ready item has a higher priority than the current task
  *     run item
  *     mark as waiting
  * ----------------------------------------------------------------------------
@@ -35,51 +39,49 @@
 inline void
 modm::Scheduler::scheduleInterupt()
 {
-	if (taskList == 0) {
-		// nothing to schedule right now
-		return;
-	}
-
-	// update all tasks
-	TaskListItem *item = taskList;
-	do {
-		item->time--;
-		if (item->time == 0) {
-			item->time = item->period;
+	ticks++;
 
-			// add to ready list
-			if ((readyList == 0) ||
-				(readyList->priority < item->priority))
-			{
-				item->nextReady = readyList;
-				readyList = item;
-			}
-			else {
-				TaskListItem *list = readyList;
+	// the slots of the coarser levels are due when all finer levels wrapped
+	uint8_t levels = 1;
+	while (levels < wheelLevels and
+		   (ticks & ((1u << (wheelBits * levels)) - 1)) == 0) {
+		levels++;
+	}
+	while (--levels) {
+		cascade(levels);
+	}
 
-				while (true)
-				{
-					if ((list->nextReady == 0) ||
-						(list->nextReady->priority < item->priority))
-					{
-						item->nextReady = list->nextReady;
-						list->nextReady = item;
-						break;
-					}
-					list = list->nextReady;
-				}
-			}
-			item->state = TaskListItem::READY;
+	// all tasks in the current slot of the finest level are due
+	TaskListItem **slot = &wheel[0][ticks % wheelSlots];
+	TaskListItem *item = *slot;
+	*slot = 0;
+	while (item != 0)
+	{
+		TaskListItem *next = item->nextTask;
+		item->time += item->period;
+		insertTask(item);
+		if (!(item->state & TaskListItem::READY) && item->priority > 0) {
+			addReady(item);
 		}
+		item = next;
 	}
-	while ((item = item->nextTask) != 0);
 
 	// now execute the tasks which are ready
-	while (((item = modm::accessor::asVolatile(readyList)) != 0) &&
-			(item->priority > currentPriority))
+	const Priority previousPriority = currentPriority;
+	uint32_t mask;
+	while ((mask = modm::accessor::asVolatile(readyMask)) != 0)
 	{
-		item->state = TaskListItem::RUNNING;
-		readyList = item->nextReady;
+		const uint8_t bucket = std::bit_width(mask) - 1;
+		item = readyList[bucket];
+		if (item->priority <= currentPriority) {
+			break;
+		}
+
+		readyList[bucket] = item->nextReady;
+		if (readyList[bucket] == 0) {
+			readyMask &= ~(uint32_t(1) << bucket);
+		}
+		item->state = (item->state & ~TaskListItem::READY) | TaskListItem::RUNNING;
 		currentPriority = item->priority;
 		{
 			modm::atomic::Unlock();
@@ -88,7 +90,57 @@ modm::Scheduler::scheduleInterupt()
 			// enabled
 			item->task.run();
 		}
-		currentPriority = 0;
-		item->state = TaskListItem::WAITING;
+		currentPriority = previousPriority;
+		item->state &= ~TaskListItem::RUNNING;
+		if (item->state & TaskListItem::REMOVED) {
+			// the task removed itself while it was running
+			delete item;
+		}
 	}
 }
+
+// ----------------------------------------------------------------------------
+inline void
+modm::Scheduler::insertTask(TaskListItem *item)
+{
+	// the level is chosen by the number of ticks until the task is due
+	const uint16_t delta = item->time - ticks;
+	uint8_t level = 0;
+	while (level < wheelLevels - 1 && (delta >> (wheelBits * (level + 1))) != 0) {
+		level++;
+	}
+
+	TaskListItem **slot = &wheel[level][(item->time >> (wheelBits * level)) % wheelSlots];
+	item->nextTask = *slot;
+	if (*slot != 0) {
+		(*slot)->previousTask = &item->nextTask;
+	}
+	item->previousTask = slot;
+	*slot = item;
+}
+
+inline void
+modm::Scheduler::unlinkTask(TaskListItem *item)
+{
+	*item->previousTask = item->nextTask;
+	if (item->nextTask != 0) {
+		item->nextTask->previousTask = item->previousTask;
+	}
+}
+
+inline void
+modm::Scheduler::addReady(TaskListItem *item)
+{
+	const uint8_t bucket = item->priority / (256 / readyBuckets);
+
+	// tasks with the same priority are run in the order they became ready
+	TaskListItem **node = &readyList[bucket];
+	while (*node != 0 && (*node)->priority >= item->priority) {
+		node = &(*node)->nextReady;
+	}
+	item->nextReady = *node;
+	*node = item;
+
+	item->state |= TaskListItem::READY;
+	readyMask |= uint32_t(1) << bucket;
+}
@@ -14,3 +14,5 @@
 #include "timer/timestamp.hpp"
 #include "timer/timeout.hpp"
 #include "timer/periodic_timer.hpp"
+#include "timer/timer_wheel.hpp"
+#include "timer/deadline.hpp"
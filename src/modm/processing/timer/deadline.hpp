@@ -0,0 +1,163 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+#include "timeout.hpp"
+#include "timer_wheel.hpp"
+#include <modm/architecture/detect.hpp>
+#include <algorithm>
+
+#if defined MODM_OS_LINUX
+#include <time.h>
+#elif defined MODM_OS_HOSTED
+#include <thread>
+#elif defined MODM_CPU_ARM && __has_include(<modm/platform/clock/systick_timer.hpp>)
+#include <modm/platform/clock/systick_timer.hpp>
+#endif
+
+namespace modm
+{
+
+/**
+ * Puts the CPU to sleep for at most the interval.
+ *
+ * On hosted Linux the thread sleeps in `clock_nanosleep()`. On Cortex-M the
+ * CPU waits for an interrupt with `WFI` and returns after the first interrupt,
+ * which is at the latest the SysTick interrupt. Intervals shorter than the
+ * SysTick interrupt interval are busy-waited, so that the deadline is not
+ * missed. On all other platforms this function busy-waits.
+ *
+ * @note Returns early if the CPU is woken up, so that the caller can check for
+ *       new events and compute a new deadline.
+ *
+ * @ingroup	modm_processing_timer
+ */
+inline void
+idle_for(std::chrono::microseconds interval)
+{
+	if (interval.count() <= 0) return;
+#if defined MODM_OS_LINUX
+	timespec time{};
+	time.tv_sec = interval.count() / 1'000'000;
+	time.tv_nsec = (interval.count() % 1'000'000) * 1000;
+	clock_nanosleep(CLOCK_MONOTONIC, 0, &time, nullptr);
+#elif defined MODM_OS_HOSTED
+	std::this_thread::sleep_for(interval);
+#else
+#if defined MODM_CPU_ARM && __has_include(<modm/platform/clock/systick_timer.hpp>)
+	if (interval >= platform::SysTickTimer::interrupt_interval)
+	{
+		asm volatile ("wfi");
+		return;
+	}
+#endif
+	const auto start = PreciseClock::now();
+	while ((PreciseClock::now() - start) < interval) ;
+#endif
+}
+
+/**
+ * Earliest deadline of multiple timers.
+ *
+ * Instead of polling all timers in a busy loop, the application adds its timers
+ * to a deadline after it handled all events and then idles until the earliest
+ * of them expires:
+ *
+ * ```cpp
+ * while (true)
+ * {
+ *     if (timeout.execute()) handleTimeout();
+ *     if (timer.execute()) handleTimer();
+ *     wheel.update();
+ *
+ *     modm::Deadline deadline;
+ *     deadline.add(timeout);
+ *     deadline.add(timer);
+ *     deadline.add(wheel);
+ *     deadline.idle();
+ * }
+ * ```
+ *
+ * Stopped timeouts and timeouts whose expiration was already returned by
+ * `execute()` are ignored, timeouts that expired but were not executed yet are
+ * due immediately. If no timer was added, there is no deadline.
+ *
+ * Inside a fiber, pass `remaining()` to `modm::fiber::sleep_for()` instead, so
+ * that the fiber scheduler idles until the earliest deadline of all fibers.
+ *
+ * @ingroup	modm_processing_timer
+ */
+class Deadline
+{
+public:
+	using duration = std::chrono::microseconds;
+
+	/// Adds a timeout or periodic timer with any resolution.
+	template< class Clock, class Duration >
+	void
+	add(const GenericTimeout<Clock, Duration>& timeout)
+	{
+		using Timeout = GenericTimeout<Clock, Duration>;
+		if (timeout._state & (Timeout::STOPPED | Timeout::EXECUTED)) return;
+		add(timeout.remaining());
+	}
+
+	/// Adds the next update of a timer wheel.
+	template< class Clock >
+	void
+	add(const GenericTimerWheel<Clock>& wheel)
+	{
+		if (not wheel.empty()) add(wheel.nextUpdate());
+	}
+
+	/// Adds a time point of any clock.
+	template< class Clock, class Duration >
+	void
+	add(std::chrono::time_point<Clock, Duration> time)
+	{
+		using rep = std::make_signed_t<typename Clock::rep>;
+		// the difference of two unsigned time points wraps around
+		const std::chrono::duration<rep, typename Clock::period> interval{
+			rep((time - Clock::now()).count())};
+		add(interval);
+	}
+
+	/// Adds the time remaining until a deadline.
+	template< typename Rep, typename Period >
+	void
+	add(std::chrono::duration<Rep, Period> remaining)
+	{
+		const auto interval = std::chrono::ceil<duration>(remaining);
+		earliest = std::min(earliest, std::max(interval, duration{0}));
+	}
+
+	/// @return `true` if no deadline was added.
+	bool
+	empty() const
+	{ return earliest == duration::max(); }
+
+	/// @return the time remaining until the earliest deadline, zero if it has
+	///         passed, or the maximum duration if no deadline was added.
+	duration
+	remaining() const
+	{ return earliest; }
+
+	/// Puts the CPU to sleep until the earliest deadline via `modm::idle_for()`.
+	/// Returns immediately if no deadline was added.
+	void
+	idle() const
+	{
+		if (not empty()) idle_for(earliest);
+	}
+
+private:
+	duration earliest{duration::max()};
+};
+
+}	// namespace modm
@@ -36,6 +36,7 @@ TimerState : uint8_t
 // forward declaration for friending
 template< class Clock, class Duration >
 class GenericPeriodicTimer;
+class Deadline;
 
 /**
  * Generic software timeout class for variable timebase and timestamp width.
@@ -142,6 +143,8 @@ protected:
 
 	friend class
 	GenericPeriodicTimer<Clock, Duration>;
+	friend class
+	Deadline;
 };
 
 /**
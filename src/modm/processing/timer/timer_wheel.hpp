@@ -0,0 +1,229 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#pragma once
+#include <modm/architecture/interface/clock.hpp>
+#include <modm/utils/inplace_function.hpp>
+#include <type_traits>
+
+#if defined __DOXYGEN__ || !defined MODM_TIMER_WHEEL_CALLBACK_STORAGE
+/// Storage size of the timer wheel callbacks in bytes
+#define MODM_TIMER_WHEEL_CALLBACK_STORAGE sizeof(void*)
+#endif
+
+namespace modm
+{
+
+/**
+ * Software timer service backed by a hierarchical timing wheel.
+ *
+ * Instead of polling every timer, timers are armed on the wheel, which sorts
+ * them into slots by the clock tick at which they expire. `update()` reads the
+ * clock once, advances the wheel to the current tick and calls the callbacks of
+ * all expired timers. Arming and stopping a timer are constant time and
+ * `update()` only visits the slots that contain timers.
+ *
+ * The wheel has four levels of 64 slots, the first level covers the next 64
+ * ticks, each further level 64 times the range of the previous level. Timers
+ * are moved to a finer level at most three times before they expire. Timers
+ * further in the future than 2^24 ticks are moved between the slots of the
+ * last level until they are in range.
+ *
+ * @warning The wheel and its timers must only be used from one context, for
+ *          example the main loop or a fiber, not from interrupts.
+ *
+ * @tparam	Clock
+ * 		Used clock which inherits from modm::Clock with a 32-bit duration.
+ *
+ * @ingroup	modm_processing_timer
+ */
+template< class Clock >
+class GenericTimerWheel
+{
+	static_assert(std::is_same_v<typename Clock::rep, uint32_t>,
+				  "The timer wheel requires a 32-bit clock!");
+
+public:
+	using clock = Clock;
+	using duration = typename Clock::duration;
+	using time_point = typename Clock::time_point;
+	using Callback = modm::inplace_function<void(), MODM_TIMER_WHEEL_CALLBACK_STORAGE, alignof(void*)>;
+
+	/**
+	 * Intrusive timer that can be armed on a timer wheel.
+	 *
+	 * The timer stores its callback and the links of the wheel, so arming it
+	 * does not allocate. It is stopped automatically when destructed.
+	 */
+	class Timer
+	{
+		friend class GenericTimerWheel;
+
+	public:
+		Timer() = default;
+
+		explicit
+		Timer(Callback&& callback) :
+			callback(std::move(callback)) {}
+
+		Timer(const Timer&) = delete;
+		Timer& operator=(const Timer&) = delete;
+
+		~Timer()
+		{ unlink(); }
+
+		/// Set the function called when the timer expires.
+		void
+		setCallback(Callback&& callback)
+		{ this->callback = std::move(callback); }
+
+		/// @return `true` if the timer is waiting to expire.
+		bool
+		isArmed() const
+		{ return previous != nullptr; }
+
+		/// @return `true` if the timer has expired since it was last started.
+		bool
+		isExpired() const
+		{ return expired; }
+
+		/// @return `true` exactly once after the timer expired.
+		/// This does not read the clock, so it is cheap to poll from a
+		/// protothread or resumable function.
+		bool
+		execute()
+		{
+			const bool result = expired;
+			expired = false;
+			return result;
+		}
+
+		/// @return the interval of a periodic timer, or zero.
+		duration
+		period() const
+		{ return duration{interval}; }
+
+	private:
+		void
+		unlink()
+		{
+			if (previous == nullptr) return;
+			*previous = next;
+			if (next) next->previous = previous;
+			previous = nullptr;
+		}
+
+		Timer* next{nullptr};
+		/// Pointer that points to this timer in its slot
+		Timer** previous{nullptr};
+		uint32_t expiry{0};
+		uint32_t interval{0};
+		bool expired{false};
+		Callback callback;
+	};
+
+public:
+	GenericTimerWheel();
+
+	GenericTimerWheel(const GenericTimerWheel&) = delete;
+	GenericTimerWheel& operator=(const GenericTimerWheel&) = delete;
+
+	/// Arms the timer to expire once after the interval.
+	/// A timer that is already armed is restarted.
+	template< typename Rep, typename Period >
+	void
+	start(Timer& timer, std::chrono::duration<Rep, Period> interval);
+
+	/// Arms the timer to expire periodically with the interval.
+	/// A periodic timer keeps its period independently of when `update()` is
+	/// called, missed periods call the callback once each.
+	template< typename Rep, typename Period >
+	void
+	startPeriodic(Timer& timer, std::chrono::duration<Rep, Period> interval);
+
+	/// Disarms the timer without calling its callback.
+	static void
+	stop(Timer& timer);
+
+	/**
+	 * Advances the wheel to the current time of the clock, marks all timers
+	 * that expired as expired and calls their callbacks in order of expiry.
+	 * The callbacks may start and stop any timer, including their own.
+	 *
+	 * @warning Must be called at least once every 2^31 ticks, otherwise the
+	 *          wheel cannot tell the time of the clock apart from the past.
+	 *
+	 * @return the number of expired timers.
+	 */
+	size_t
+	update();
+
+	/// Advances the wheel to the time point, see `update()`.
+	size_t
+	update(time_point now);
+
+	/// @return `true` if no timer is armed.
+	bool
+	empty() const;
+
+	/// @return the time at which `update()` must be called next, which is in
+	///         the past if the wheel lags behind the clock. Only valid if the
+	///         wheel is not empty.
+	time_point
+	nextUpdate() const
+	{ return time_point{duration{nextEvent()}}; }
+
+protected:
+	static constexpr uint8_t Bits = 6;
+	static constexpr uint8_t Slots = 1 << Bits;
+	static constexpr uint8_t Levels = 4;
+	static constexpr uint32_t Range = uint32_t(1) << (Bits * Levels);
+
+	void
+	arm(Timer& timer, uint32_t ticks, uint32_t interval);
+
+	void
+	insert(Timer& timer);
+
+	/// @return the next tick after `current` at which a slot must be processed.
+	uint32_t
+	nextEvent() const;
+
+	void
+	cascade(uint8_t level);
+
+	size_t
+	expire();
+
+	static uint32_t
+	ticks(time_point time)
+	{ return std::chrono::time_point_cast<duration>(time).time_since_epoch().count(); }
+
+	template< typename Rep, typename Period >
+	static uint32_t
+	ticks(std::chrono::duration<Rep, Period> interval);
+
+	Timer* wheel[Levels][Slots];
+	/// Bitmap of the slots that may contain timers per level
+	uint64_t occupied[Levels];
+	/// The last processed tick
+	uint32_t current;
+};
+
+/// Timer wheel with millisecond resolution.
+/// @ingroup	modm_processing_timer
+using TimerWheel = GenericTimerWheel< Clock >;
+
+/// Timer wheel with microsecond resolution.
+/// @ingroup	modm_processing_timer
+using PreciseTimerWheel = GenericTimerWheel< PreciseClock >;
+
+}	// namespace modm
+
+#include "timer_wheel_impl.hpp"
@@ -0,0 +1,209 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <bit>
+
+template< class Clock >
+modm::GenericTimerWheel<Clock>::GenericTimerWheel() :
+	wheel(), occupied(), current(ticks(Clock::now()))
+{
+}
+
+template< class Clock >
+template< typename Rep, typename Period >
+uint32_t
+modm::GenericTimerWheel<Clock>::ticks(std::chrono::duration<Rep, Period> interval)
+{
+	if (interval.count() <= 0) return 0;
+	// round up, so that a timer never expires early
+	return std::chrono::ceil<duration>(interval).count();
+}
+
+// ----------------------------------------------------------------------------
+template< class Clock >
+template< typename Rep, typename Period >
+void
+modm::GenericTimerWheel<Clock>::start(Timer& timer, std::chrono::duration<Rep, Period> interval)
+{
+	arm(timer, ticks(interval), 0);
+}
+
+template< class Clock >
+template< typename Rep, typename Period >
+void
+modm::GenericTimerWheel<Clock>::startPeriodic(Timer& timer, std::chrono::duration<Rep, Period> interval)
+{
+	const uint32_t period = ticks(interval);
+	arm(timer, period, period ? period : 1);
+}
+
+template< class Clock >
+void
+modm::GenericTimerWheel<Clock>::stop(Timer& timer)
+{
+	timer.unlink();
+	timer.expired = false;
+}
+
+template< class Clock >
+void
+modm::GenericTimerWheel<Clock>::arm(Timer& timer, uint32_t delay, uint32_t interval)
+{
+	timer.unlink();
+	timer.expired = false;
+	timer.interval = interval;
+	// The interval starts now, however, the wheel may lag behind the clock
+	// and a timer can only expire after the last processed tick.
+	uint32_t expiry = ticks(Clock::now()) + delay;
+	if (int32_t(expiry - current) <= 0) expiry = current + 1;
+	timer.expiry = expiry;
+	insert(timer);
+}
+
+template< class Clock >
+void
+modm::GenericTimerWheel<Clock>::insert(Timer& timer)
+{
+	// Timers that are out of range wait in the last level
+	uint32_t delta = timer.expiry - current;
+	uint32_t slot_time = timer.expiry;
+	if (delta >= Range)
+	{
+		delta = Range - 1;
+		slot_time = current + delta;
+	}
+
+	uint8_t level = 0;
+	while (level < Levels - 1 and (delta >> (Bits * (level + 1))))
+		level++;
+	const uint8_t index = (slot_time >> (Bits * level)) & (Slots - 1);
+
+	Timer** slot = &wheel[level][index];
+	timer.next = *slot;
+	if (*slot) (*slot)->previous = &timer.next;
+	timer.previous = slot;
+	*slot = &timer;
+	occupied[level] |= uint64_t(1) << index;
+}
+
+// ----------------------------------------------------------------------------
+template< class Clock >
+size_t
+modm::GenericTimerWheel<Clock>::update()
+{
+	return update(Clock::now());
+}
+
+template< class Clock >
+size_t
+modm::GenericTimerWheel<Clock>::update(time_point now)
+{
+	const uint32_t target = ticks(now);
+	size_t count{0};
+	while (int32_t(target - current) > 0)
+	{
+		const uint32_t next = nextEvent();
+		if (next == current or int32_t(next - target) > 0)
+		{
+			current = target;
+			break;
+		}
+		current = next;
+		// move the timers of the coarser slots starting now to finer levels
+		for (uint8_t level = Levels - 1; level > 0; level--)
+		{
+			if ((current & ((uint32_t(1) << (Bits * level)) - 1)) == 0)
+				cascade(level);
+		}
+		count += expire();
+	}
+	return count;
+}
+
+template< class Clock >
+uint32_t
+modm::GenericTimerWheel<Clock>::nextEvent() const
+{
+	uint32_t earliest{0};
+	for (uint8_t level = 0; level < Levels; level++)
+	{
+		const uint64_t slots = occupied[level];
+		if (slots == 0) continue;
+
+		// slots up to the current index are processed in the next revolution
+		const uint8_t shift = Bits * level;
+		const uint8_t index = (current >> shift) & (Slots - 1);
+		const uint32_t revolution = uint64_t(1) << (shift + Bits);
+		uint32_t time = current & ~(revolution - 1);
+		const uint64_t later = (index == Slots - 1) ? 0 : slots & (~uint64_t(0) << (index + 1));
+		if (later) time += uint32_t(std::countr_zero(later)) << shift;
+		else time += revolution + (uint32_t(std::countr_zero(slots)) << shift);
+
+		const uint32_t offset = time - current;
+		if (earliest == 0 or offset < earliest) earliest = offset;
+	}
+	return current + earliest;
+}
+
+template< class Clock >
+void
+modm::GenericTimerWheel<Clock>::cascade(uint8_t level)
+{
+	const uint8_t index = (current >> (Bits * level)) & (Slots - 1);
+	Timer* timer = wheel[level][index];
+	wheel[level][index] = nullptr;
+	occupied[level] &= ~(uint64_t(1) << index);
+
+	while (timer)
+	{
+		Timer* next = timer->next;
+		insert(*timer);
+		timer = next;
+	}
+}
+
+template< class Clock >
+size_t
+modm::GenericTimerWheel<Clock>::expire()
+{
+	const uint8_t index = current & (Slots - 1);
+	occupied[0] &= ~(uint64_t(1) << index);
+
+	// All timers in this slot expire now. Periodic timers are rearmed before
+	// the callback, so that the callback may stop or restart them.
+	size_t count{0};
+	while (Timer* timer = wheel[0][index])
+	{
+		timer->unlink();
+		timer->expired = true;
+		if (timer->interval)
+		{
+			timer->expiry += timer->interval;
+			insert(*timer);
+		}
+		count++;
+		if (timer->callback) timer->callback();
+	}
+	return count;
+}
+
+template< class Clock >
+bool
+modm::GenericTimerWheel<Clock>::empty() const
+{
+	for (uint8_t level = 0; level < Levels; level++)
+	{
+		// the bitmap may contain slots whose timers were stopped
+		for (uint64_t slots = occupied[level]; slots; slots &= slots - 1)
+		{
+			if (wheel[level][std::countr_zero(slots)]) return false;
+		}
+	}
+	return true;
+}
@@ -16,6 +16,7 @@
 
 #include <cstddef>
 #include <new>		// needed for placement new
+#include <utility>
 
 namespace modm
 {
@@ -37,17 +38,18 @@ namespace modm
 			 * \brief	Construct an object
 			 *
 			 * Constructs an object of type T (the template parameter) on the
-			 * location pointed by p using its copy constructor to initialize
-			 * its value to \p value.
+			 * location pointed by p using the constructor matching \p args,
+			 * for example the copy or move constructor.
 			 *
 			 * Notice that this does not allocate space for the element, it
 			 * should already be available at p.
 			 */
+			template <typename... Args>
 			static inline void
-			construct(T* p, const T& value)
+			construct(T* p, Args&&... args)
 			{
 				// placement new
-				::new((void *) p) T(value);
+				::new((void *) p) T(std::forward<Args>(args)...);
 			}
 
 			/**
@@ -15,6 +15,10 @@
 #define MODM_ALLOCATOR_BLOCK_HPP
 
 #include "allocator_base.hpp"
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <modm/architecture/interface/assert.hpp>
 
 namespace modm
 {
@@ -28,7 +32,30 @@ namespace modm
 		 * allocator.
 		 * If more memory is needed a new block is allocated.
 		 *
-		 * This technique is known as "memory pool".
+		 * This technique is known as "memory pool". Freed pieces are kept in
+		 * an intrusive free list, so that both allocate() and deallocate()
+		 * take constant time and the heap is only used once per block of
+		 * \p BLOCKSIZE objects.
+		 *
+		 * Optionally, the allocator can be given a statically allocated
+		 * storage, which is used up before any block is allocated from the
+		 * heap. Since a container rebinds the allocator to its node type,
+		 * the storage is given as raw memory and split into nodes by the
+		 * container:
+		 *
+		 * \code
+		 * alignas(std::max_align_t) static std::byte storage[512];
+		 * modm::LinkedList<int, modm::allocator::Block<int, 16> >
+		 *         list({storage, sizeof(storage)});
+		 * \endcode
+		 *
+		 * \warning	Only single objects can be allocated, so this allocator
+		 * 			cannot be used for the modm::DynamicArray. The allocator
+		 * 			cannot be copied and the storage is handed over to the
+		 * 			first container that is given the allocator.
+		 *
+		 * \tparam	BLOCKSIZE	Number of objects per block allocated from
+		 * 						the heap.
 		 *
 		 * \ingroup	modm_utils_allocator
 		 * \author	Fabian Greif
@@ -37,6 +64,11 @@ namespace modm
 				  std::size_t BLOCKSIZE>
 		class Block : public AllocatorBase<T>
 		{
+			static_assert(BLOCKSIZE > 0, "A block must contain at least one object!");
+
+			template <typename U, std::size_t>
+			friend class Block;
+
 		public:
 			template <typename U>
 			struct rebind
@@ -50,23 +82,112 @@ namespace modm
 			{
 			}
 
-			Block(const Block& other) :
-				AllocatorBase<T>(other)
+			/**
+			 * \brief	Use the storage before allocating from the heap
+			 *
+			 * \param	storage	Memory that outlives the allocator
+			 * \param	size	Size of the memory in bytes
+			 */
+			Block(void* storage, std::size_t size) :
+				AllocatorBase<T>(),
+				storage(storage), storageSize(size)
 			{
 			}
 
+			Block(const Block&) = delete;
+
+			Block&
+			operator = (const Block&) = delete;
+
+			/**
+			 * \brief	Takes the unused storage over from the given allocator
+			 *
+			 * This is how a container creates its node allocator from the
+			 * allocator it is given. The storage then belongs to the new
+			 * allocator and \p other allocates from the heap only, so that
+			 * both never hand out the same memory.
+			 */
 			template <typename U>
-			Block(const Block<U, BLOCKSIZE>&) :
-				AllocatorBase<T>()
+			Block(const Block<U, BLOCKSIZE>& other) :
+				AllocatorBase<T>(),
+				storage(std::exchange(other.storage, nullptr)),
+				storageSize(std::exchange(other.storageSize, 0))
+			{
+			}
+
+			~Block()
 			{
+				while (chunks)
+				{
+					Chunk* next = chunks->next;
+					delete chunks;
+					chunks = next;
+				}
 			}
 
-			// TODO
 			T*
-			allocate();
+			allocate(std::size_t n = 1)
+			{
+				if (not modm_assert_continue_fail(n == 1, "block.alloc",
+						"Block allocator can only allocate single objects!", n)) {
+					return nullptr;
+				}
+
+				// reuse the most recently freed object
+				if (freeList)
+				{
+					Slot* slot = freeList;
+					freeList = slot->next;
+					return reinterpret_cast<T*>(slot);
+				}
+				// then use up the static storage
+				if (std::align(alignof(Slot), sizeof(Slot), storage, storageSize))
+				{
+					Slot* slot = static_cast<Slot*>(storage);
+					storage = slot + 1;
+					storageSize -= sizeof(Slot);
+					return reinterpret_cast<T*>(slot);
+				}
+				// and only then allocate a new block from the heap
+				if (remaining == 0)
+				{
+					Chunk* chunk = new Chunk;
+					chunk->next = chunks;
+					chunks = chunk;
+					remaining = BLOCKSIZE;
+				}
+				return reinterpret_cast<T*>(&chunks->slots[--remaining]);
+			}
 
 			void
-			deallocate(T*);
+			deallocate(T* p)
+			{
+				Slot* slot = reinterpret_cast<Slot*>(p);
+				slot->next = freeList;
+				freeList = slot;
+			}
+
+		private:
+			union Slot
+			{
+				Slot* next;
+				alignas(T) std::byte value[sizeof(T)];
+			};
+
+			struct Chunk
+			{
+				Chunk* next;
+				Slot slots[BLOCKSIZE];
+			};
+
+			Slot* freeList = nullptr;
+			Chunk* chunks = nullptr;
+			std::size_t remaining = 0;
+
+			// containers pass the allocator by const reference, but the
+			// storage must still move to their node allocator
+			mutable void* storage = nullptr;
+			mutable std::size_t storageSize = 0;
 		};
 	}
 }
@@ -0,0 +1,185 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/architecture/driver/atomic/spsc_queue.hpp>
+
+#include "atomic_spsc_queue_test.hpp"
+
+#ifdef MODM_OS_HOSTED
+#include <thread>
+#endif
+
+void
+AtomicSpscQueueTest::testQueue()
+{
+	modm::atomic::SpscQueue<int16_t, 4> queue;
+
+	TEST_ASSERT_TRUE(queue.isEmpty());
+	TEST_ASSERT_EQUALS(queue.getMaxSize(), 4);
+	TEST_ASSERT_EQUALS(queue.getSize(), 0);
+
+	TEST_ASSERT_TRUE(queue.push(1));
+	TEST_ASSERT_TRUE(queue.push(2));
+	TEST_ASSERT_TRUE(queue.push(3));
+	TEST_ASSERT_TRUE(queue.push(4));
+
+	// all elements of the buffer are used
+	TEST_ASSERT_FALSE(queue.push(5));
+	TEST_ASSERT_TRUE(queue.isFull());
+	TEST_ASSERT_EQUALS(queue.getSize(), 4);
+
+	TEST_ASSERT_EQUALS(queue.get(), 1);
+	queue.pop();
+
+	int16_t value{0};
+	TEST_ASSERT_TRUE(queue.pop(value));
+	TEST_ASSERT_EQUALS(value, 2);
+
+	TEST_ASSERT_TRUE(queue.push(5));
+	TEST_ASSERT_TRUE(queue.push(6));
+	TEST_ASSERT_TRUE(queue.isFull());
+
+	for (int16_t expected : {3, 4, 5, 6})
+	{
+		TEST_ASSERT_TRUE(queue.pop(value));
+		TEST_ASSERT_EQUALS(value, expected);
+	}
+	TEST_ASSERT_TRUE(queue.isEmpty());
+	TEST_ASSERT_FALSE(queue.pop(value));
+}
+
+void
+AtomicSpscQueueTest::testIndexOverflow()
+{
+	// the 8-bit indices overflow many times
+	modm::atomic::SpscQueue<uint16_t, 128> queue;
+	uint16_t value{0};
+	bool correct{true};
+	for (uint16_t ii = 0; ii < 2000; ii++)
+	{
+		correct &= queue.push(ii);
+		if (ii >= 127)
+		{
+			correct &= (queue.getSize() == 128);
+			correct &= queue.isFull();
+			correct &= queue.pop(value);
+			correct &= (value == uint16_t(ii - 127));
+		}
+	}
+	TEST_ASSERT_TRUE(correct);
+	TEST_ASSERT_EQUALS(queue.getSize(), 127);
+}
+
+void
+AtomicSpscQueueTest::testBulk()
+{
+	modm::atomic::SpscQueue<uint8_t, 8> queue;
+	const uint8_t input[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	uint8_t output[10] = {};
+
+	// only the free space is pushed
+	TEST_ASSERT_EQUALS(queue.push(std::span{input, 5}), 5u);
+	TEST_ASSERT_EQUALS(queue.push(std::span{input + 5, 5}), 3u);
+	TEST_ASSERT_TRUE(queue.isFull());
+
+	TEST_ASSERT_EQUALS(queue.pop(std::span{output, 6}), 6u);
+	TEST_ASSERT_EQUALS_ARRAY(output, input, 6);
+
+	// the pushed data wraps around the end of the buffer
+	TEST_ASSERT_EQUALS(queue.push(std::span{input, 10}), 6u);
+	TEST_ASSERT_EQUALS(queue.getSize(), 8);
+
+	TEST_ASSERT_EQUALS(queue.pop(output), 8u);
+	const uint8_t expected[8] = {6, 7, 0, 1, 2, 3, 4, 5};
+	TEST_ASSERT_EQUALS_ARRAY(output, expected, 8);
+	TEST_ASSERT_TRUE(queue.isEmpty());
+	TEST_ASSERT_EQUALS(queue.pop(output), 0u);
+}
+
+void
+AtomicSpscQueueTest::testSpans()
+{
+	modm::atomic::SpscQueue<uint8_t, 8> queue;
+
+	auto region = queue.pushSpan();
+	TEST_ASSERT_EQUALS(region.size(), 8u);
+	for (uint8_t ii = 0; ii < 6; ii++) region[ii] = ii;
+	queue.commitPush(6);
+	TEST_ASSERT_EQUALS(queue.getSize(), 6);
+
+	auto stored = queue.popSpan();
+	TEST_ASSERT_EQUALS(stored.size(), 6u);
+	TEST_ASSERT_EQUALS(stored[5], 5);
+	queue.commitPop(4);
+
+	// the free region ends at the end of the buffer
+	region = queue.pushSpan();
+	TEST_ASSERT_EQUALS(region.size(), 2u);
+	region[0] = 6; region[1] = 7;
+	queue.commitPush(2);
+	region = queue.pushSpan();
+	TEST_ASSERT_EQUALS(region.size(), 4u);
+	region[0] = 8;
+	queue.commitPush(1);
+
+	// the stored region also ends at the end of the buffer
+	stored = queue.popSpan();
+	TEST_ASSERT_EQUALS(stored.size(), 4u);
+	TEST_ASSERT_EQUALS(stored[0], 4);
+	TEST_ASSERT_EQUALS(stored[3], 7);
+	queue.commitPop(4);
+	stored = queue.popSpan();
+	TEST_ASSERT_EQUALS(stored.size(), 1u);
+	TEST_ASSERT_EQUALS(stored[0], 8);
+	queue.commitPop(1);
+	TEST_ASSERT_TRUE(queue.isEmpty());
+	TEST_ASSERT_EQUALS(queue.popSpan().size(), 0u);
+}
+
+void
+AtomicSpscQueueTest::testThreads()
+{
+#ifdef MODM_OS_HOSTED
+	static modm::atomic::SpscQueue<uint32_t, 64> queue;
+	constexpr uint32_t count = 100'000;
+
+	std::thread producer([]
+	{
+		uint32_t values[7];
+		for (uint32_t next = 0; next < count; )
+		{
+			// alternate between single and bulk pushes
+			uint32_t pushed{0};
+			if (next & 1) {
+				pushed = queue.push(next);
+			} else {
+				const uint32_t size = std::min<uint32_t>(7, count - next);
+				for (uint32_t ii = 0; ii < size; ii++) values[ii] = next + ii;
+				pushed = queue.push(std::span{values, size});
+			}
+			if (pushed == 0) std::this_thread::yield();
+			next += pushed;
+		}
+	});
+
+	bool ordered{true};
+	uint32_t values[5];
+	for (uint32_t expected = 0; expected < count; )
+	{
+		const size_t size = queue.pop(values);
+		if (size == 0) std::this_thread::yield();
+		for (size_t ii = 0; ii < size; ii++)
+			ordered &= (values[ii] == expected++);
+	}
+	producer.join();
+
+	TEST_ASSERT_TRUE(ordered);
+	TEST_ASSERT_TRUE(queue.isEmpty());
+#endif
+}
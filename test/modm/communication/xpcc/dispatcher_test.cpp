@@ -163,6 +163,24 @@ DispatcherTest::testEventTransmission()
 	TEST_ASSERT_EQUALS(backend->messagesSend.getFront().header, header);
 }
 
+void
+DispatcherTest::testEventTransmissionWithoutAllocation()
+{
+	const std::size_t allocated = modm::SmartPointer::getNumberOfAllocatedPayloads();
+
+	uint64_t payload = 0x0123456789abcdef;
+	component2->publishEvent(0x21, payload);
+
+	dispatcher->update();
+
+	TEST_ASSERT_EQUALS(timeline->events.getSize(), 1U);
+	TEST_ASSERT_EQUALS(timeline->events.getFront().payload.get<uint64_t>(), payload);
+	TEST_ASSERT_EQUALS(backend->messagesSend.getSize(), 1U);
+	TEST_ASSERT_EQUALS(backend->messagesSend.getFront().payload.get<uint64_t>(), payload);
+
+	TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated);
+}
+
 void
 DispatcherTest::testInternalActionCallNoParameter()
 {
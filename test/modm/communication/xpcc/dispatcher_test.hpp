@@ -73,6 +73,10 @@ public:
 	void
 	testEventTransmission();
 
+	// Payloads of up to eight bytes must not allocate memory
+	void
+	testEventTransmissionWithoutAllocation();
+
 	/*
 	 * Step 3:
 	 * Check internal action calls
@@ -0,0 +1,196 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "block_allocator_test.hpp"
+#include <modm/utils/allocator.hpp>
+#include <modm/container/linked_list.hpp>
+#include <modm/container/doubly_linked_list.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace
+{
+
+template< typename T >
+bool
+inside(const T* object, const std::byte* storage, std::size_t size)
+{
+	const auto* begin = reinterpret_cast<const std::byte*>(object);
+	return begin >= storage and (begin + sizeof(T)) <= (storage + size);
+}
+
+}
+
+void
+BlockAllocatorTest::testReuse()
+{
+	modm::allocator::Block<uint32_t, 4> allocator;
+
+	uint32_t* a = allocator.allocate(1);
+	uint32_t* b = allocator.allocate(1);
+	uint32_t* c = allocator.allocate(1);
+	TEST_ASSERT_TRUE(a != b);
+	TEST_ASSERT_TRUE(b != c);
+	TEST_ASSERT_TRUE(a != c);
+
+	// the most recently freed object is reused first
+	allocator.deallocate(b);
+	allocator.deallocate(a);
+	TEST_ASSERT_TRUE(allocator.allocate(1) == a);
+	TEST_ASSERT_TRUE(allocator.allocate(1) == b);
+
+	allocator.deallocate(a);
+	allocator.deallocate(b);
+	allocator.deallocate(c);
+}
+
+void
+BlockAllocatorTest::testBlocks()
+{
+	modm::allocator::Block<uint64_t, 3> allocator;
+
+	// more objects than fit into a single block
+	uint64_t* objects[10];
+	for (uint8_t ii = 0; ii < 10; ii++)
+	{
+		objects[ii] = allocator.allocate(1);
+		TEST_ASSERT_EQUALS(reinterpret_cast<uintptr_t>(objects[ii]) % alignof(uint64_t), 0u);
+		*objects[ii] = ii;
+	}
+	for (uint8_t ii = 0; ii < 10; ii++)
+	{
+		TEST_ASSERT_EQUALS(*objects[ii], ii);
+	}
+	for (uint64_t* object : objects) allocator.deallocate(object);
+}
+
+void
+BlockAllocatorTest::testStorage()
+{
+	// every object also needs space for a pointer while it is free
+	alignas(uint64_t) std::byte storage[3 * sizeof(uint64_t)];
+	modm::allocator::Block<uint64_t, 4> allocator(storage, sizeof(storage));
+
+	uint64_t* objects[5];
+	for (uint64_t*& object : objects) object = allocator.allocate(1);
+
+	// the storage is used up first
+	TEST_ASSERT_TRUE(inside(objects[0], storage, sizeof(storage)));
+	TEST_ASSERT_TRUE(inside(objects[1], storage, sizeof(storage)));
+	TEST_ASSERT_TRUE(inside(objects[2], storage, sizeof(storage)));
+	TEST_ASSERT_FALSE(inside(objects[3], storage, sizeof(storage)));
+	TEST_ASSERT_FALSE(inside(objects[4], storage, sizeof(storage)));
+
+	// both kinds of objects are reused
+	allocator.deallocate(objects[1]);
+	allocator.deallocate(objects[4]);
+	TEST_ASSERT_TRUE(allocator.allocate(1) == objects[4]);
+	TEST_ASSERT_TRUE(allocator.allocate(1) == objects[1]);
+
+	for (uint64_t* object : objects) allocator.deallocate(object);
+
+	// an unaligned storage is aligned
+	modm::allocator::Block<uint64_t, 4> unaligned(storage + 1, sizeof(storage) - 1);
+	uint64_t* object = unaligned.allocate(1);
+	TEST_ASSERT_EQUALS(reinterpret_cast<uintptr_t>(object) % alignof(uint64_t), 0u);
+	TEST_ASSERT_TRUE(inside(object, storage, sizeof(storage)));
+	unaligned.deallocate(object);
+}
+
+void
+BlockAllocatorTest::testLinkedList()
+{
+	alignas(std::max_align_t) std::byte storage[128];
+	using Allocator = modm::allocator::Block<int16_t, 4>;
+	modm::LinkedList<int16_t, Allocator> list(Allocator(storage, sizeof(storage)));
+
+	// the nodes are taken from the storage
+	list.append(1);
+	list.prepend(0);
+	TEST_ASSERT_TRUE(inside(&list.getFront(), storage, sizeof(storage)));
+	TEST_ASSERT_TRUE(inside(&list.getBack(), storage, sizeof(storage)));
+
+	// and from the heap once the storage is used up
+	for (int16_t ii = 2; ii < 100; ii++) list.append(ii);
+	TEST_ASSERT_EQUALS(list.getSize(), 100u);
+	TEST_ASSERT_FALSE(inside(&list.getBack(), storage, sizeof(storage)));
+
+	int16_t expected{0};
+	for (const int16_t value : list)
+	{
+		TEST_ASSERT_EQUALS(value, expected);
+		expected++;
+	}
+
+	// removed nodes are reused
+	const int16_t* front = &list.getFront();
+	list.removeFront();
+	list.append(100);
+	TEST_ASSERT_TRUE(&list.getBack() == front);
+	TEST_ASSERT_EQUALS(list.getBack(), 100);
+
+	list.removeAll();
+	TEST_ASSERT_TRUE(list.isEmpty());
+}
+
+void
+BlockAllocatorTest::testHandOver()
+{
+	alignas(std::max_align_t) std::byte storage[128];
+	using Allocator = modm::allocator::Block<int16_t, 4>;
+	static_assert(not std::is_copy_constructible_v<Allocator>);
+	Allocator allocator(storage, sizeof(storage));
+
+	// the first list takes the storage over, the second one gets none
+	modm::LinkedList<int16_t, Allocator> list(allocator);
+	modm::LinkedList<int16_t, Allocator> second(allocator);
+	for (int16_t ii = 0; ii < 4; ii++)
+	{
+		list.append(ii);
+		second.append(ii);
+	}
+	TEST_ASSERT_TRUE(inside(&list.getFront(), storage, sizeof(storage)));
+
+	// the nodes of the second list are never taken from the storage
+	for (const int16_t& value : second)
+	{
+		TEST_ASSERT_FALSE(inside(&value, storage, sizeof(storage)));
+		for (const int16_t& other : list) {
+			TEST_ASSERT_TRUE(&value != &other);
+		}
+	}
+
+	// neither are the objects of the original allocator
+	int16_t* object = allocator.allocate(1);
+	TEST_ASSERT_FALSE(inside(object, storage, sizeof(storage)));
+	allocator.deallocate(object);
+}
+
+void
+BlockAllocatorTest::testDoublyLinkedList()
+{
+	modm::DoublyLinkedList<int32_t, modm::allocator::Block<int32_t, 2> > list;
+
+	for (int32_t ii = 0; ii < 5; ii++) list.append(ii);
+	list.prepend(-1);
+	TEST_ASSERT_EQUALS(list.getFront(), -1);
+	TEST_ASSERT_EQUALS(list.getBack(), 4);
+
+	list.removeBack();
+	list.removeFront();
+	TEST_ASSERT_EQUALS(list.getFront(), 0);
+	TEST_ASSERT_EQUALS(list.getBack(), 3);
+
+	list.append(10);
+	list.prepend(-10);
+	TEST_ASSERT_EQUALS(list.getFront(), -10);
+	TEST_ASSERT_EQUALS(list.getBack(), 10);
+	TEST_ASSERT_EQUALS(list.getSize(), 6u);
+}
@@ -0,0 +1,33 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <unittest/testsuite.hpp>
+
+/// @ingroup modm_test_test_container
+class BlockAllocatorTest : public unittest::TestSuite
+{
+public:
+	void
+	testReuse();
+
+	void
+	testBlocks();
+
+	void
+	testStorage();
+
+	void
+	testLinkedList();
+
+	void
+	testHandOver();
+
+	void
+	testDoublyLinkedList();
+};
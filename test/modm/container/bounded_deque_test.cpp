@@ -14,6 +14,7 @@
 // ----------------------------------------------------------------------------
 
 #include <modm/container/deque.hpp>
+#include <cstring>
 
 #include "bounded_deque_test.hpp"
 
@@ -368,3 +369,109 @@ BoundedDequeTest::testElementAccess()
 	TEST_ASSERT_EQUALS(deque.rget(2), 2);
 
 }
+
+void
+BoundedDequeTest::testSpans()
+{
+	modm::BoundedDeque<uint8_t, 8> deque;
+
+	auto occupied = deque.getOccupiedSpans();
+	TEST_ASSERT_EQUALS(occupied[0].size(), 0U);
+	TEST_ASSERT_EQUALS(occupied[1].size(), 0U);
+
+	auto free = deque.getFreeSpans();
+	TEST_ASSERT_EQUALS(free[0].size() + free[1].size(), 8U);
+
+	// write three items after the back
+	const uint8_t data[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+	std::memcpy(free[0].data(), data, 3);
+	deque.commit(3);
+
+	TEST_ASSERT_EQUALS(deque.getSize(), 3U);
+	TEST_ASSERT_EQUALS(deque.getFront(), 1);
+	TEST_ASSERT_EQUALS(deque.getBack(), 3);
+
+	deque.append(4);
+	occupied = deque.getOccupiedSpans();
+	TEST_ASSERT_EQUALS(occupied[0].size() + occupied[1].size(), 4U);
+	TEST_ASSERT_EQUALS(occupied[0][0], 1);
+
+	deque.consume(2);
+	TEST_ASSERT_EQUALS(deque.getSize(), 2U);
+	TEST_ASSERT_EQUALS(deque.getFront(), 3);
+
+	// fill the deque completely, wrapping around the end of the buffer
+	free = deque.getFreeSpans();
+	TEST_ASSERT_EQUALS(free[0].size() + free[1].size(), 6U);
+	TEST_ASSERT_TRUE(free[1].size() > 0);
+	std::memcpy(free[0].data(), data + 4, free[0].size());
+	std::memcpy(free[1].data(), data + 4 + free[0].size(), free[1].size());
+	deque.commit(6);
+	TEST_ASSERT_TRUE(deque.isFull());
+
+	free = deque.getFreeSpans();
+	TEST_ASSERT_EQUALS(free[0].size() + free[1].size(), 0U);
+
+	for (uint8_t i = 0; i < 8; ++i) {
+		TEST_ASSERT_EQUALS(deque[i], i + 3);
+	}
+
+	const auto& constDeque = deque;
+	const auto constOccupied = constDeque.getOccupiedSpans();
+	TEST_ASSERT_EQUALS(constOccupied[0].size() + constOccupied[1].size(), 8U);
+
+	deque.consume(8);
+	TEST_ASSERT_TRUE(deque.isEmpty());
+}
+
+void
+BoundedDequeTest::testSpansWrapAround()
+{
+	modm::BoundedDeque<int16_t, 5> deque;
+
+	for (int16_t rotation = 0; rotation < 5; ++rotation)
+	{
+		for (uint8_t count = 0; count <= 5; ++count)
+		{
+			deque.clear();
+			// rotate the position of the front
+			for (int16_t i = 0; i < rotation; ++i) {
+				deque.append(0);
+				deque.removeFront();
+			}
+
+			auto free = deque.getFreeSpans();
+			TEST_ASSERT_EQUALS(free[0].size() + free[1].size(), 5U);
+
+			int16_t value = 0;
+			for (auto span : free) {
+				for (int16_t& item : span) {
+					item = value++;
+				}
+			}
+			deque.commit(count);
+
+			TEST_ASSERT_EQUALS(deque.getSize(), count);
+			for (uint8_t i = 0; i < count; ++i) {
+				TEST_ASSERT_EQUALS(deque[i], i);
+			}
+
+			auto occupied = deque.getOccupiedSpans();
+			TEST_ASSERT_EQUALS(occupied[0].size() + occupied[1].size(), count);
+			value = 0;
+			for (auto span : occupied) {
+				for (int16_t item : span) {
+					TEST_ASSERT_EQUALS(item, value++);
+				}
+			}
+
+			// element-wise access continues after bulk access
+			if (count < 5) {
+				TEST_ASSERT_TRUE(deque.append(100));
+				TEST_ASSERT_EQUALS(deque.getBack(), 100);
+			}
+			deque.consume(count);
+			TEST_ASSERT_EQUALS(deque.getSize(), (count < 5) ? 1U : 0U);
+		}
+	}
+}
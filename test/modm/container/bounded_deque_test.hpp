@@ -46,4 +46,11 @@ public:
 
 	void
 	testElementAccess();
+
+	void
+	testSpans();
+
+	// Bulk access must match the element-wise access for every rotation
+	void
+	testSpansWrapAround();
 };
@@ -0,0 +1,223 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/container/bounded_priority_queue.hpp>
+
+#include "bounded_priority_queue_test.hpp"
+
+namespace
+{
+
+struct Timeout
+{
+	uint32_t time;
+	uint8_t task;
+};
+
+struct Later
+{
+	constexpr bool
+	operator()(const Timeout& a, const Timeout& b) const
+	{ return a.time > b.time; }
+};
+
+constexpr uint16_t
+sum()
+{
+	modm::BoundedPriorityQueue<uint8_t, 8> queue;
+	for (uint8_t value : {3, 7, 1, 5}) queue.push(value);
+
+	uint16_t result = 0;
+	while (not queue.isEmpty())
+	{
+		result = result * 10 + queue.getTop();
+		queue.pop();
+	}
+	return result;
+}
+
+/// Pseudo random numbers, which are the same on every target
+uint16_t
+nextRandom()
+{
+	static uint32_t state = 12345;
+	state = state * 1103515245ul + 12345ul;
+	return state >> 16;
+}
+
+}
+
+void
+BoundedPriorityQueueTest::testPushPop()
+{
+	modm::BoundedPriorityQueue<int16_t, 8> queue;
+	TEST_ASSERT_TRUE(queue.isEmpty());
+	TEST_ASSERT_EQUALS(queue.getMaxSize(), 8U);
+
+	for (int16_t value : {4, -2, 9, 4, 0, 12}) {
+		TEST_ASSERT_TRUE(queue.push(value).isValid());
+	}
+	TEST_ASSERT_EQUALS(queue.getSize(), 6U);
+
+	// the largest item comes first
+	for (int16_t expected : {12, 9, 4, 4, 0, -2})
+	{
+		TEST_ASSERT_EQUALS(queue.getTop(), expected);
+		queue.pop();
+	}
+	TEST_ASSERT_TRUE(queue.isEmpty());
+}
+
+void
+BoundedPriorityQueueTest::testCompare()
+{
+	modm::BoundedPriorityQueue<Timeout, 4, Later> timeouts;
+	timeouts.push({30, 1});
+	timeouts.push({10, 2});
+	timeouts.push({20, 3});
+
+	// the earliest timeout comes first
+	TEST_ASSERT_EQUALS(timeouts.getTop().task, 2);
+	timeouts.pop();
+	TEST_ASSERT_EQUALS(timeouts.getTop().task, 3);
+	timeouts.pop();
+	TEST_ASSERT_EQUALS(timeouts.getTop().task, 1);
+}
+
+void
+BoundedPriorityQueueTest::testFull()
+{
+	modm::BoundedPriorityQueue<uint8_t, 3> queue;
+	auto a = queue.push(1);
+	queue.push(2);
+	queue.push(3);
+	TEST_ASSERT_TRUE(queue.isFull());
+
+	auto handle = queue.push(4);
+	TEST_ASSERT_FALSE(handle.isValid());
+	TEST_ASSERT_FALSE(queue.contains(handle));
+	TEST_ASSERT_EQUALS(queue.getSize(), 3U);
+	TEST_ASSERT_EQUALS(queue.getTop(), 3);
+
+	queue.clear();
+	TEST_ASSERT_TRUE(queue.isEmpty());
+	TEST_ASSERT_FALSE(queue.contains(a));
+
+	// the queue can be filled again after clear()
+	for (uint8_t value : {5, 6, 4}) queue.push(value);
+	TEST_ASSERT_EQUALS(queue.getTop(), 6);
+}
+
+void
+BoundedPriorityQueueTest::testUpdate()
+{
+	modm::BoundedPriorityQueue<Timeout, 8, Later> timeouts;
+	auto a = timeouts.push({100, 1});
+	auto b = timeouts.push({200, 2});
+	auto c = timeouts.push({300, 3});
+	timeouts.push({400, 4});
+
+	// decrease the key of the last item
+	timeouts.update(c, {50, 3});
+	TEST_ASSERT_TRUE(timeouts.getTopHandle() == c);
+	TEST_ASSERT_EQUALS(timeouts.get(c).time, 50U);
+
+	// increase the key of the first item
+	timeouts.update(c, {250, 3});
+	TEST_ASSERT_TRUE(timeouts.getTopHandle() == a);
+	timeouts.update(a, {500, 1});
+
+	// the handles still refer to the same items
+	TEST_ASSERT_EQUALS(timeouts.get(a).task, 1);
+	TEST_ASSERT_EQUALS(timeouts.get(b).task, 2);
+	TEST_ASSERT_EQUALS(timeouts.get(c).task, 3);
+
+	for (uint8_t expected : {2, 3, 4, 1})
+	{
+		TEST_ASSERT_EQUALS(timeouts.getTop().task, expected);
+		timeouts.pop();
+	}
+}
+
+void
+BoundedPriorityQueueTest::testRemove()
+{
+	modm::BoundedPriorityQueue<uint8_t, 8> queue;
+	auto a = queue.push(10);
+	auto b = queue.push(20);
+	auto c = queue.push(30);
+	auto d = queue.push(40);
+
+	TEST_ASSERT_TRUE(queue.remove(b));
+	TEST_ASSERT_FALSE(queue.contains(b));
+	TEST_ASSERT_FALSE(queue.remove(b));
+	TEST_ASSERT_EQUALS(queue.getSize(), 3U);
+
+	TEST_ASSERT_TRUE(queue.remove(d));
+	TEST_ASSERT_EQUALS(queue.getTop(), 30);
+	TEST_ASSERT_TRUE(queue.contains(a));
+	TEST_ASSERT_TRUE(queue.contains(c));
+
+	queue.pop();
+	TEST_ASSERT_FALSE(queue.contains(c));
+	TEST_ASSERT_EQUALS(queue.getTop(), 10);
+	TEST_ASSERT_TRUE(queue.getTopHandle() == a);
+}
+
+void
+BoundedPriorityQueueTest::testConstexpr()
+{
+	static_assert(sum() == 7531);
+	TEST_ASSERT_EQUALS(sum(), 7531U);
+}
+
+void
+BoundedPriorityQueueTest::testRandom()
+{
+	using Queue = modm::BoundedPriorityQueue<uint16_t, 64>;
+	Queue queue;
+	Queue::Handle handles[64];
+
+	for (uint16_t round = 0; round < 200; ++round)
+	{
+		const uint16_t value = nextRandom();
+		switch (nextRandom() % 4)
+		{
+			case 0:
+			case 1:
+				if (queue.isNotFull()) {
+					handles[queue.getSize()] = queue.push(value);
+				}
+				break;
+			case 2:
+			{
+				// change a random item which is still in the queue
+				const Queue::Handle handle = handles[value % 64];
+				if (queue.contains(handle)) {
+					queue.update(handle, nextRandom());
+				}
+				break;
+			}
+			default:
+				if (queue.isNotEmpty()) {
+					queue.pop();
+				}
+				break;
+		}
+	}
+
+	// items must come out in descending order
+	uint16_t previous = 0xffff;
+	while (queue.isNotEmpty())
+	{
+		TEST_ASSERT_TRUE(queue.getTop() <= previous);
+		previous = queue.getTop();
+		queue.pop();
+	}
+}
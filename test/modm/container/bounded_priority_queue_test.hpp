@@ -0,0 +1,37 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <unittest/testsuite.hpp>
+
+/// @ingroup modm_test_test_container
+class BoundedPriorityQueueTest : public unittest::TestSuite
+{
+public:
+	void
+	testPushPop();
+
+	void
+	testCompare();
+
+	void
+	testFull();
+
+	void
+	testUpdate();
+
+	void
+	testRemove();
+
+	void
+	testConstexpr();
+
+	// Random operations must keep the items in order
+	void
+	testRandom();
+};
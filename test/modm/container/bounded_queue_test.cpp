@@ -60,3 +60,28 @@ BoundedQueueTest::testQueue()
 
 	TEST_ASSERT_TRUE(queue.isEmpty());
 }
+
+void
+BoundedQueueTest::testSpans()
+{
+	modm::BoundedQueue<int16_t, 5> queue;
+
+	TEST_ASSERT_TRUE(queue.push(1));
+	queue.pop();
+
+	auto free = queue.getFreeSpans();
+	TEST_ASSERT_EQUALS(free[0].size() + free[1].size(), 5U);
+	free[0][0] = 10;
+	free[0][1] = 11;
+	queue.commit(2);
+
+	TEST_ASSERT_EQUALS(queue.getSize(), 2U);
+	TEST_ASSERT_EQUALS(queue.get(), 10);
+
+	const auto occupied = queue.getOccupiedSpans();
+	TEST_ASSERT_EQUALS(occupied[0].size(), 2U);
+	TEST_ASSERT_EQUALS(occupied[0][1], 11);
+
+	queue.consume(2);
+	TEST_ASSERT_TRUE(queue.isEmpty());
+}
@@ -19,4 +19,7 @@ class BoundedQueueTest : public unittest::TestSuite
 public:
 	void
 	testQueue();
+
+	void
+	testSpans();
 };
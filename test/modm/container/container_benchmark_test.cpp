@@ -0,0 +1,634 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/container/deque.hpp>
+#include <modm/container/doubly_linked_list.hpp>
+#include <modm/container/dynamic_array.hpp>
+#include <modm/container/linked_list.hpp>
+#include <modm/container/queue.hpp>
+#include <modm/container/stack.hpp>
+#include <modm/container/bounded_priority_queue.hpp>
+#include <modm/container/static_sorted_vector.hpp>
+#include <modm/architecture/driver/atomic/queue.hpp>
+#include <modm/debug/logger.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+#include "container_benchmark_test.hpp"
+
+// The benchmarks need a cycle counter, which the AVRs and the Cortex-M0 lack
+#if defined(MODM_OS_HOSTED)
+#	include <chrono>
+#	define MODM_CONTAINER_BENCHMARK 1
+#elif defined(MODM_CPU_CORTEX_M3) or defined(MODM_CPU_CORTEX_M4) or defined(MODM_CPU_CORTEX_M33)
+#	include <modm/platform/device.hpp>
+#	define MODM_CONTAINER_BENCHMARK 1
+#endif
+
+#ifdef MODM_CONTAINER_BENCHMARK
+/*
+ * Every measurement prints one line of space separated key=value pairs in
+ * this order, the time is the average of one operation on one element:
+ *
+ * container-benchmark container=LinkedList element=16 n=32 op=append
+ *     time=12.50 unit=ns allocations=32 peak_heap=1024 object=12
+ *
+ * - allocations: number of heap allocations during the operation
+ * - peak_heap: largest heap usage of the container during the round in bytes
+ * - object: size of the container object itself in bytes
+ */
+namespace
+{
+
+#ifdef MODM_OS_HOSTED
+constexpr uint32_t rounds = 1000;
+
+/// Measures nanoseconds
+struct Stopwatch
+{
+	static constexpr const char* unit = "ns";
+
+	Stopwatch() :
+		start(std::chrono::steady_clock::now())
+	{
+	}
+
+	uint32_t
+	elapsed() const
+	{
+		const auto diff = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(diff).count();
+	}
+
+	std::chrono::steady_clock::time_point start;
+};
+#else
+constexpr uint32_t rounds = 10;
+
+/// Measures CPU cycles with the DWT counter enabled by modm:architecture:delay
+struct Stopwatch
+{
+	static constexpr const char* unit = "cycles";
+
+	Stopwatch() :
+		start(DWT->CYCCNT)
+	{
+	}
+
+	uint32_t
+	elapsed() const
+	{
+		return DWT->CYCCNT - start;
+	}
+
+	uint32_t start;
+};
+#endif
+
+constexpr uint8_t elements = 32;
+
+/// Heap usage of the CountingAllocator
+struct Heap
+{
+	static inline std::size_t allocations{0};
+	static inline std::size_t used{0};
+	static inline std::size_t peak{0};
+
+	static void
+	reset()
+	{
+		allocations = 0;
+		peak = used;
+	}
+};
+
+/// Counts the allocations and the heap usage of a container
+template <typename T>
+class CountingAllocator : public modm::allocator::AllocatorBase<T>
+{
+	// the size of the allocation is stored in front of it
+	static constexpr std::size_t header = alignof(std::max_align_t);
+
+public:
+	template <typename U>
+	struct rebind
+	{
+		using other = CountingAllocator<U>;
+	};
+
+	CountingAllocator() = default;
+
+	template <typename U>
+	CountingAllocator(const CountingAllocator<U>&)
+	{
+	}
+
+	T*
+	allocate(std::size_t n)
+	{
+		const std::size_t bytes = n * sizeof(T);
+		uint8_t* memory = static_cast<uint8_t*>(::operator new(header + bytes));
+		*reinterpret_cast<std::size_t*>(memory) = bytes;
+
+		Heap::allocations++;
+		Heap::used += bytes;
+		Heap::peak = std::max(Heap::peak, Heap::used);
+		return reinterpret_cast<T*>(memory + header);
+	}
+
+	void
+	deallocate(T* p)
+	{
+		uint8_t* memory = reinterpret_cast<uint8_t*>(p) - header;
+		Heap::used -= *reinterpret_cast<std::size_t*>(memory);
+		::operator delete(memory);
+	}
+};
+
+template <std::size_t Size>
+struct Element
+{
+	Element() = default;
+
+	Element(uint8_t value)
+	{
+		data[0] = value;
+	}
+
+	uint8_t data[Size]{};
+};
+
+template <std::size_t Size>
+struct Before
+{
+	constexpr bool
+	operator()(const Element<Size>& a, const Element<Size>& b) const
+	{ return a.data[0] < b.data[0]; }
+};
+
+template <std::size_t Size>
+struct After
+{
+	constexpr bool
+	operator()(const Element<Size>& a, const Element<Size>& b) const
+	{ return a.data[0] > b.data[0]; }
+};
+
+/// Keys in a scrambled order for the sorted containers
+constexpr uint8_t
+key(uint8_t index)
+{ return (index * 37u) % 251u; }
+
+/// Accumulates the time and the allocations of one operation over all rounds
+struct Operation
+{
+	const char* name{nullptr};
+	uint8_t count{0};
+	uint32_t time{0};
+	std::size_t allocations{0};
+
+	template <typename Function>
+	void
+	operator()(const char* name, uint8_t count, Function&& function)
+	{
+		this->name = name;
+		this->count = count;
+		const std::size_t allocations = Heap::allocations;
+		const Stopwatch stopwatch;
+		function();
+		this->time += stopwatch.elapsed();
+		this->allocations += Heap::allocations - allocations;
+	}
+};
+
+struct Result
+{
+	const char* container;
+	std::size_t element;
+	std::size_t object;
+	std::size_t peak_heap{0};
+};
+
+void
+report(const Result& result, const Operation& operation)
+{
+	if (operation.name == nullptr) {
+		return;
+	}
+	// two decimal places without floating point support in the IOStream
+	const uint32_t time = uint64_t(operation.time) * 100 / (uint32_t(rounds) * operation.count);
+	MODM_LOG_INFO << "container-benchmark container=" << result.container
+				  << " element=" << uint32_t(result.element)
+				  << " n=" << operation.count
+				  << " op=" << operation.name
+				  << " time=" << (time / 100) << '.' << ((time % 100) < 10 ? "0" : "")
+				  << (time % 100)
+				  << " unit=" << Stopwatch::unit
+				  << " allocations=" << uint32_t(operation.allocations / rounds)
+				  << " peak_heap=" << uint32_t(result.peak_heap)
+				  << " object=" << uint32_t(result.object) << modm::endl;
+}
+
+/// Keeps the compiler from removing the iteration
+volatile uint32_t sink;
+
+/**
+ * Runs the operations of a container in every round and reports them.
+ *
+ * The round function gets the operations in the order push, iterate, insert,
+ * erase and pop, and may leave out the ones the container does not support.
+ */
+template <typename Container, typename Function>
+std::size_t
+benchmark(const char* name, std::size_t element, Function&& round)
+{
+	Operation operations[5];
+	Result result{name, element, sizeof(Container)};
+
+	// the first round only warms up the caches
+	round(operations);
+	for (Operation& operation : operations) operation = Operation{};
+
+	for (uint32_t ii = 0; ii < rounds; ++ii)
+	{
+		Heap::reset();
+		round(operations);
+		result.peak_heap = std::max(result.peak_heap, Heap::peak);
+	}
+	for (const Operation& operation : operations) {
+		report(result, operation);
+	}
+	return result.peak_heap;
+}
+
+// ----------------------------------------------------------------------------
+template <std::size_t Size>
+void
+benchmarkLinkedList()
+{
+	using T = Element<Size>;
+	using Container = modm::LinkedList<T, CountingAllocator<T>>;
+	const std::size_t peak = benchmark<Container>("LinkedList", Size, [](Operation* op)
+	{
+		Container list;
+		op[0]("append", elements, [&] {
+			for (uint8_t ii = 0; ii < elements; ++ii) list.append(T(ii));
+		});
+		op[1]("iterate", elements, [&] {
+			uint32_t sum = 0;
+			for (const T& value : list) sum += value.data[0];
+			sink = sum;
+		});
+		auto middle = list.begin();
+		for (uint8_t ii = 0; ii < elements / 2; ++ii) ++middle;
+		op[2]("insert", elements / 4, [&] {
+			for (uint8_t ii = 0; ii < elements / 4; ++ii) list.insert(middle, T(ii));
+		});
+		op[3]("remove", elements / 4, [&] {
+			for (uint8_t ii = 0; ii < elements / 4; ++ii)
+			{
+				auto next = middle;
+				list.remove(++next);
+			}
+		});
+		op[4]("removeFront", elements, [&] {
+			for (uint8_t ii = 0; ii < elements; ++ii) list.removeFront();
+		});
+	});
+	TEST_ASSERT_EQUALS(Heap::used, 0U);
+	TEST_ASSERT_TRUE(peak >= (elements + elements / 4) * sizeof(T));
+}
+
+template <std::size_t Size>
+void
+benchmarkDoublyLinkedList()
+{
+	using T = Element<Size>;
+	using Container = modm::DoublyLinkedList<T, CountingAllocator<T>>;
+	const std::size_t peak = benchmark<Container>("DoublyLinkedList", Size, [](Operation* op)
+	{
+		Container list;
+		op[0]("append", elements, [&] {
+			for (uint8_t ii = 0; ii < elements; ++ii) list.append(T(ii));
+		});
+		op[1]("iterate", elements, [&] {
+			uint32_t sum = 0;
+			for (const T& value : list) sum += value.data[0];
+			sink = sum;
+		});
+		auto middle = list.begin();
+		for (uint8_t ii = 0; ii < elements / 2; ++ii) ++middle;
+		op[3]("erase", elements / 4, [&] {
+			for (uint8_t ii = 0; ii < elements / 4; ++ii) middle = list.erase(middle);
+		});
+		op[4]("removeFront", elements - elements / 4, [&] {
+			for (uint8_t ii = 0; ii < elements - elements / 4; ++ii) list.removeFront();
+		});
+	});
+	TEST_ASSERT_EQUALS(Heap::used, 0U);
+	TEST_ASSERT_TRUE(peak >= elements * sizeof(T));
+}
+
+template <std::size_t Size>
+void
+benchmarkDynamicArray()
+{
+	using T = Element<Size>;
+	using Container = modm::DynamicArray<T, CountingAllocator<T>>;
+	const std::size_t peak = benchmark<Container>("DynamicArray", Size, [](Operation* op)
+	{
+		Container array;
+		op[0]("append", elements, [&] {
+			for (uint8_t ii = 0; ii < elements; ++ii) array.append(T(ii));
+		});
+		op[1]("iterate", elements, [&] {
+			uint32_t sum = 0;
+			for (std::size_t ii = 0; ii < array.getSize(); ++ii) sum += array[ii].data[0];
+			sink = sum;
+		});
+		op[4]("removeBack", elements, [&] {
+			for (uint8_t ii = 0; ii < elements; ++ii) array.removeBack();
+		});
+	});
+	TEST_ASSERT_EQUALS(Heap::used, 0U);
+	TEST_ASSERT_TRUE(peak >= elements * sizeof(T));
+}
+
+template <std::size_t Size>
+void
+benchmarkBoundedDeque()
+{
+	using T = Element<Size>;
+	using Container = modm::BoundedDeque<T, elements>;
+	const std::size_t peak = benchmark<Container>("BoundedDeque", Size, [](Operation* op)
+	{
+		static Container deque;
+		op[0]("append", elements, [&] {
+			for (uint8_t ii = 0; ii < elements; ++ii) deque.append(T(ii));
+		});
+		op[1]("iterate", elements, [&] {
+			uint32_t sum = 0;
+			for (const T& value : deque) sum += value.data[0];
+			sink = sum;
+		});
+		op[4]("removeFront", elements, [&] {
+			for (uint8_t ii = 0; ii < elements; ++ii) deque.removeFront();
+		});
+	});
+	TEST_ASSERT_EQUALS(peak, 0U);
+}
+
+template <std::size_t Size>
+void
+benchmarkBoundedQueue()
+{
+	using T = Element<Size>;
+	using Container = modm::BoundedQueue<T, elements>;
+	const std::size_t peak = benchmark<Container>("BoundedQueue", Size, [](Operation* op)
+	{
+		static Container queue;
+		op[0]("push", elements, [&] {
+			for (uint8_t ii = 0; ii < elements; ++ii) queue.push(T(ii));
+		});
+		op[4]("pop", elements, [&] {
+			uint32_t sum = 0;
+			for (uint8_t ii = 0; ii < elements; ++ii) {
+				sum += queue.get().data[0];
+				queue.pop();
+			}
+			sink = sum;
+		});
+	});
+	TEST_ASSERT_EQUALS(peak, 0U);
+}
+
+template <std::size_t Size>
+void
+benchmarkBoundedStack()
+{
+	using T = Element<Size>;
+	using Container = modm::BoundedStack<T, elements>;
+	const std::size_t peak = benchmark<Container>("BoundedStack", Size, [](Operation* op)
+	{
+		static Container stack;
+		op[0]("push", elements, [&] {
+			for (uint8_t ii = 0; ii < elements; ++ii) stack.push(T(ii));
+		});
+		op[4]("pop", elements, [&] {
+			uint32_t sum = 0;
+			for (uint8_t ii = 0; ii < elements; ++ii) {
+				sum += stack.get().data[0];
+				stack.pop();
+			}
+			sink = sum;
+		});
+	});
+	TEST_ASSERT_EQUALS(peak, 0U);
+}
+
+template <std::size_t Size>
+void
+benchmarkAtomicQueue()
+{
+	using T = Element<Size>;
+	using Container = modm::atomic::Queue<T, elements>;
+	const std::size_t peak = benchmark<Container>("atomic::Queue", Size, [](Operation* op)
+	{
+		static Container queue;
+		op[0]("push", elements, [&] {
+			for (uint8_t ii = 0; ii < elements; ++ii) queue.push(T(ii));
+		});
+		op[4]("pop", elements, [&] {
+			uint32_t sum = 0;
+			for (uint8_t ii = 0; ii < elements; ++ii) {
+				sum += queue.get().data[0];
+				queue.pop();
+			}
+			sink = sum;
+		});
+	});
+	TEST_ASSERT_EQUALS(peak, 0U);
+}
+
+
+// ----------------------------------------------------------------------------
+// Sorted containers, which are compared to keeping a LinkedList sorted
+template <std::size_t Size>
+void
+benchmarkSortedLinkedList()
+{
+	using T = Element<Size>;
+	using Container = modm::LinkedList<T, CountingAllocator<T>>;
+	benchmark<Container>("LinkedList", Size, [](Operation* op)
+	{
+		Container list;
+		op[2]("insertSorted", elements, [&] {
+			for (uint8_t ii = 0; ii < elements; ++ii)
+			{
+				const T value(key(ii));
+				if (list.isEmpty() or Before<Size>{}(value, list.getFront())) {
+					list.prepend(value);
+					continue;
+				}
+				// insert after the last item which is not ordered after the value
+				auto position = list.begin();
+				for (auto next = position; ++next != list.end() and
+					 not Before<Size>{}(value, *next); position = next) {}
+				list.insert(position, value);
+			}
+		});
+		op[4]("removeFront", elements, [&] {
+			for (uint8_t ii = 0; ii < elements; ++ii) list.removeFront();
+		});
+	});
+	TEST_ASSERT_EQUALS(Heap::used, 0U);
+}
+
+template <std::size_t Size>
+void
+benchmarkBoundedPriorityQueue()
+{
+	using T = Element<Size>;
+	// the smallest key comes first like in the sorted list
+	using Container = modm::BoundedPriorityQueue<T, elements, After<Size>>;
+	const std::size_t peak = benchmark<Container>("BoundedPriorityQueue", Size, [](Operation* op)
+	{
+		static Container queue;
+		op[2]("push", elements, [&] {
+			for (uint8_t ii = 0; ii < elements; ++ii) queue.push(T(key(ii)));
+		});
+		op[4]("pop", elements, [&] {
+			uint32_t sum = 0;
+			for (uint8_t ii = 0; ii < elements; ++ii) {
+				sum += queue.getTop().data[0];
+				queue.pop();
+			}
+			sink = sum;
+		});
+	});
+	TEST_ASSERT_EQUALS(peak, 0U);
+}
+
+template <std::size_t Size>
+void
+benchmarkStaticSortedVector()
+{
+	using T = Element<Size>;
+	using Container = modm::StaticSortedVector<T, elements, Before<Size>>;
+	const std::size_t peak = benchmark<Container>("StaticSortedVector", Size, [](Operation* op)
+	{
+		static Container vector;
+		op[2]("insert", elements, [&] {
+			for (uint8_t ii = 0; ii < elements; ++ii) vector.insert(T(key(ii)));
+		});
+		op[3]("find", elements, [&] {
+			uint32_t found = 0;
+			for (uint8_t ii = 0; ii < elements; ++ii) found += vector.contains(T(key(ii)));
+			sink = found;
+		});
+		op[4]("removeFront", elements, [&] {
+			for (uint8_t ii = 0; ii < elements; ++ii) vector.removeFront();
+		});
+	});
+	TEST_ASSERT_EQUALS(peak, 0U);
+}
+
+}	// namespace
+#endif
+
+// ----------------------------------------------------------------------------
+void
+ContainerBenchmarkTest::testLinkedList()
+{
+#ifdef MODM_CONTAINER_BENCHMARK
+	benchmarkLinkedList<4>();
+	benchmarkLinkedList<16>();
+	benchmarkLinkedList<64>();
+#endif
+}
+
+void
+ContainerBenchmarkTest::testDoublyLinkedList()
+{
+#ifdef MODM_CONTAINER_BENCHMARK
+	benchmarkDoublyLinkedList<4>();
+	benchmarkDoublyLinkedList<16>();
+	benchmarkDoublyLinkedList<64>();
+#endif
+}
+
+void
+ContainerBenchmarkTest::testDynamicArray()
+{
+#ifdef MODM_CONTAINER_BENCHMARK
+	benchmarkDynamicArray<4>();
+	benchmarkDynamicArray<16>();
+	benchmarkDynamicArray<64>();
+#endif
+}
+
+void
+ContainerBenchmarkTest::testBoundedDeque()
+{
+#ifdef MODM_CONTAINER_BENCHMARK
+	benchmarkBoundedDeque<4>();
+	benchmarkBoundedDeque<16>();
+	benchmarkBoundedDeque<64>();
+#endif
+}
+
+void
+ContainerBenchmarkTest::testBoundedQueue()
+{
+#ifdef MODM_CONTAINER_BENCHMARK
+	benchmarkBoundedQueue<4>();
+	benchmarkBoundedQueue<16>();
+	benchmarkBoundedQueue<64>();
+#endif
+}
+
+void
+ContainerBenchmarkTest::testBoundedStack()
+{
+#ifdef MODM_CONTAINER_BENCHMARK
+	benchmarkBoundedStack<4>();
+	benchmarkBoundedStack<16>();
+	benchmarkBoundedStack<64>();
+#endif
+}
+
+void
+ContainerBenchmarkTest::testAtomicQueue()
+{
+#ifdef MODM_CONTAINER_BENCHMARK
+	benchmarkAtomicQueue<4>();
+	benchmarkAtomicQueue<16>();
+	benchmarkAtomicQueue<64>();
+#endif
+}
+
+void
+ContainerBenchmarkTest::testSortedContainers()
+{
+#ifdef MODM_CONTAINER_BENCHMARK
+	benchmarkSortedLinkedList<4>();
+	benchmarkBoundedPriorityQueue<4>();
+	benchmarkStaticSortedVector<4>();
+
+	benchmarkSortedLinkedList<16>();
+	benchmarkBoundedPriorityQueue<16>();
+	benchmarkStaticSortedVector<16>();
+
+	benchmarkSortedLinkedList<64>();
+	benchmarkBoundedPriorityQueue<64>();
+	benchmarkStaticSortedVector<64>();
+#endif
+}
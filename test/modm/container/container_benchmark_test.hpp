@@ -0,0 +1,48 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <unittest/testsuite.hpp>
+
+/**
+ * Compares the cost of the common operations of the containers.
+ *
+ * Every measurement prints one line in a fixed format, which can be compared
+ * between releases with a script. The assertions only check the heap usage,
+ * since the timing depends on the target.
+ *
+ * @ingroup modm_test_test_container
+ */
+class ContainerBenchmarkTest : public unittest::TestSuite
+{
+public:
+	void
+	testLinkedList();
+
+	void
+	testDoublyLinkedList();
+
+	void
+	testDynamicArray();
+
+	void
+	testBoundedDeque();
+
+	void
+	testBoundedQueue();
+
+	void
+	testBoundedStack();
+
+	void
+	testAtomicQueue();
+
+	// Ordered insertion into a LinkedList, BoundedPriorityQueue and StaticSortedVector
+	void
+	testSortedContainers();
+};
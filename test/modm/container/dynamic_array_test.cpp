@@ -199,6 +199,217 @@ DynamicArrayTest::testRemoveAll()
 	TEST_ASSERT_EQUALS(array.getCapacity(), 5U);
 }
 
+namespace
+{
+	/// Counts moves and copies, and can only be constructed from arguments
+	struct MoveCount
+	{
+		MoveCount(int value, int factor) :
+			value(value * factor)
+		{
+		}
+
+		MoveCount(const MoveCount& other) :
+			value(other.value)
+		{
+			++copies;
+		}
+
+		MoveCount(MoveCount&& other) :
+			value(other.value)
+		{
+			other.value = -1;
+			++moves;
+		}
+
+		~MoveCount()
+		{
+			++destructions;
+		}
+
+		static void
+		reset()
+		{
+			copies = moves = destructions = 0;
+		}
+
+		int value;
+
+		static inline std::size_t copies = 0;
+		static inline std::size_t moves = 0;
+		static inline std::size_t destructions = 0;
+	};
+}
+
+void
+DynamicArrayTest::testMoveConstructor()
+{
+	Container array{1, 2, 3};
+	const int16_t* values = &array[0];
+
+	Container array2(std::move(array));
+
+	TEST_ASSERT_TRUE(array.isEmpty());
+	TEST_ASSERT_EQUALS(array2.getSize(), 3U);
+	TEST_ASSERT_EQUALS(array2[0], 1);
+	TEST_ASSERT_EQUALS(array2[2], 3);
+	// the storage was taken over and not copied
+	TEST_ASSERT_TRUE(&array2[0] == values);
+
+	// the moved-from array is still usable
+	array.append(4);
+	TEST_ASSERT_EQUALS(array.getSize(), 1U);
+	TEST_ASSERT_EQUALS(array[0], 4);
+}
+
+void
+DynamicArrayTest::testMoveAssignment()
+{
+	MoveCount::reset();
+	{
+		modm::DynamicArray<MoveCount> array;
+		array.emplaceBack(1, 1);
+		array.emplaceBack(2, 1);
+
+		modm::DynamicArray<MoveCount> array2;
+		array2.emplaceBack(3, 1);
+
+		MoveCount::reset();
+		array2 = std::move(array);
+
+		// the old element is destroyed, the others are neither copied nor moved
+		TEST_ASSERT_EQUALS(MoveCount::destructions, 1U);
+		TEST_ASSERT_EQUALS(MoveCount::copies, 0U);
+		TEST_ASSERT_EQUALS(MoveCount::moves, 0U);
+
+		TEST_ASSERT_TRUE(array.isEmpty());
+		TEST_ASSERT_EQUALS(array2.getSize(), 2U);
+		TEST_ASSERT_EQUALS(array2[0].value, 1);
+		TEST_ASSERT_EQUALS(array2[1].value, 2);
+	}
+	TEST_ASSERT_EQUALS(MoveCount::destructions, 3U);
+}
+
+void
+DynamicArrayTest::testEmplaceBack()
+{
+	MoveCount::reset();
+
+	modm::DynamicArray<MoveCount> array(2);
+	MoveCount& element = array.emplaceBack(3, 4);
+
+	TEST_ASSERT_EQUALS(array.getSize(), 1U);
+	TEST_ASSERT_EQUALS(element.value, 12);
+	TEST_ASSERT_TRUE(&element == &array[0]);
+	// constructed in place
+	TEST_ASSERT_EQUALS(MoveCount::copies, 0U);
+	TEST_ASSERT_EQUALS(MoveCount::moves, 0U);
+
+	array.append(MoveCount(5, 1));
+	TEST_ASSERT_EQUALS(array[1].value, 5);
+	TEST_ASSERT_EQUALS(MoveCount::copies, 0U);
+	TEST_ASSERT_EQUALS(MoveCount::moves, 1U);
+
+	// appending an element of the full array itself
+	array.append(array[0]);
+	TEST_ASSERT_EQUALS(array.getSize(), 3U);
+	TEST_ASSERT_EQUALS(array[0].value, 12);
+	TEST_ASSERT_EQUALS(array[1].value, 5);
+	TEST_ASSERT_EQUALS(array[2].value, 12);
+}
+
+void
+DynamicArrayTest::testRelocateMovesElements()
+{
+	MoveCount::reset();
+
+	modm::DynamicArray<MoveCount> array(2);
+	array.emplaceBack(1, 1);
+	array.emplaceBack(2, 1);
+
+	array.reserve(10);
+
+	TEST_ASSERT_EQUALS(MoveCount::copies, 0U);
+	TEST_ASSERT_EQUALS(MoveCount::moves, 2U);
+	TEST_ASSERT_EQUALS(MoveCount::destructions, 2U);
+	TEST_ASSERT_EQUALS(array[0].value, 1);
+	TEST_ASSERT_EQUALS(array[1].value, 2);
+
+	modm::DynamicArray<MoveCount> copy(array);
+	TEST_ASSERT_EQUALS(MoveCount::copies, 2U);
+	TEST_ASSERT_EQUALS(copy[1].value, 2);
+}
+
+void
+DynamicArrayTest::testGrowth()
+{
+	Container array;
+
+	std::size_t reallocations = 0;
+	std::size_t capacity = array.getCapacity();
+	for (int16_t i = 0; i < 1000; ++i)
+	{
+		array.append(i);
+		if (array.getCapacity() != capacity)
+		{
+			// the capacity grows at least by the factor of 1.5
+			TEST_ASSERT_TRUE(array.getCapacity() >= (capacity * 3) / 2);
+			capacity = array.getCapacity();
+			++reallocations;
+		}
+	}
+	for (int16_t i = 0; i < 1000; ++i) {
+		TEST_ASSERT_EQUALS(array[i], i);
+	}
+	TEST_ASSERT_TRUE(reallocations < 20);
+
+	// doubling the capacity
+	modm::DynamicArray<int16_t, modm::allocator::Dynamic<int16_t>, 0, std::ratio<2> > doubling;
+	doubling.append(1);
+	doubling.append(2);
+	doubling.append(3);
+	TEST_ASSERT_EQUALS(doubling.getCapacity(), 4U);
+}
+
+void
+DynamicArrayTest::testInlineStorage()
+{
+	typedef modm::DynamicArray<int16_t, modm::allocator::Dynamic<int16_t>, 4> InlineContainer;
+
+	InlineContainer array;
+	TEST_ASSERT_EQUALS(array.getCapacity(), 4U);
+
+	for (int16_t i = 0; i < 4; ++i) {
+		array.append(i);
+	}
+	const int16_t* values = &array[0];
+	TEST_ASSERT_EQUALS(array.getCapacity(), 4U);
+	// the elements are stored inside the array itself
+	TEST_ASSERT_TRUE(static_cast<const void*>(values) >= static_cast<const void*>(&array));
+	TEST_ASSERT_TRUE(static_cast<const void*>(values) < static_cast<const void*>(&array + 1));
+
+	// moving must copy the inline elements
+	InlineContainer moved(std::move(array));
+	TEST_ASSERT_TRUE(array.isEmpty());
+	TEST_ASSERT_EQUALS(moved.getSize(), 4U);
+	TEST_ASSERT_EQUALS(moved[3], 3);
+
+	// then spill to the heap
+	moved.append(4);
+	TEST_ASSERT_EQUALS(moved.getSize(), 5U);
+	TEST_ASSERT_TRUE(moved.getCapacity() > 4U);
+	for (int16_t i = 0; i < 5; ++i) {
+		TEST_ASSERT_EQUALS(moved[i], i);
+	}
+
+	InlineContainer copy(moved);
+	TEST_ASSERT_EQUALS(copy.getSize(), 5U);
+	TEST_ASSERT_EQUALS(copy[4], 4);
+
+	moved.clear();
+	TEST_ASSERT_EQUALS(moved.getCapacity(), 4U);
+}
+
 // ----------------------------------------------------------------------------
 
 namespace
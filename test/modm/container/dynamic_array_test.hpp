@@ -51,6 +51,24 @@ public:
 	void
 	testRemoveAll();
 
+	void
+	testMoveConstructor();
+
+	void
+	testMoveAssignment();
+
+	void
+	testEmplaceBack();
+
+	void
+	testRelocateMovesElements();
+
+	void
+	testGrowth();
+
+	void
+	testInlineStorage();
+
 	// iterators
 	void
 	testConstIterator();
@@ -0,0 +1,265 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/container/intrusive_list.hpp>
+#include <modm/container/intrusive_doubly_linked_list.hpp>
+#include <modm/container/linked_list.hpp>
+#include <modm/container/doubly_linked_list.hpp>
+
+#include "intrusive_list_test.hpp"
+
+#ifdef MODM_OS_HOSTED
+#include <chrono>
+#endif
+
+namespace
+{
+
+struct ReadyTag;
+struct TimerTag;
+
+struct Element :
+	modm::IntrusiveListHook<>,
+	modm::IntrusiveDoublyLinkedListHook<>,
+	modm::IntrusiveDoublyLinkedListHook<ReadyTag>,
+	modm::IntrusiveDoublyLinkedListHook<TimerTag>
+{
+	Element(int16_t value = 0) : value(value) {}
+	int16_t value;
+};
+
+template< class List >
+int32_t
+sum(const List& list)
+{
+	int32_t result{0};
+	for (const Element& element : list) result += element.value;
+	return result;
+}
+
+}
+
+void
+IntrusiveListTest::testList()
+{
+	modm::IntrusiveList<Element> list;
+	TEST_ASSERT_TRUE(list.isEmpty());
+	TEST_ASSERT_EQUALS(list.getSize(), 0u);
+	TEST_ASSERT_TRUE(list.begin() == list.end());
+
+	Element a{1}, b{2}, c{3};
+	list.append(b);
+	list.append(c);
+	list.prepend(a);
+	TEST_ASSERT_FALSE(list.isEmpty());
+	TEST_ASSERT_EQUALS(list.getSize(), 3u);
+	TEST_ASSERT_TRUE(&list.getFront() == &a);
+	TEST_ASSERT_TRUE(&list.getBack() == &c);
+
+	int16_t expected{1};
+	for (Element& element : list)
+	{
+		TEST_ASSERT_EQUALS(element.value, expected);
+		expected++;
+	}
+	TEST_ASSERT_EQUALS(sum(list), 6);
+
+	// the list links the elements, it does not copy them
+	b.value = 20;
+	TEST_ASSERT_EQUALS(sum(list), 24);
+
+	list.removeFront();
+	TEST_ASSERT_TRUE(&list.getFront() == &b);
+	list.removeFront();
+	list.removeFront();
+	TEST_ASSERT_TRUE(list.isEmpty());
+
+	// removed elements can be appended again
+	list.append(a);
+	TEST_ASSERT_TRUE(&list.getFront() == &a);
+	TEST_ASSERT_TRUE(&list.getBack() == &a);
+	list.removeAll();
+	TEST_ASSERT_TRUE(list.isEmpty());
+}
+
+void
+IntrusiveListTest::testListRemove()
+{
+	modm::IntrusiveList<Element> list;
+	Element a{1}, b{2}, c{3}, d{4};
+	list.append(a);
+	list.append(b);
+	list.append(c);
+
+	TEST_ASSERT_FALSE(list.remove(d));
+	TEST_ASSERT_TRUE(list.remove(c));
+	TEST_ASSERT_TRUE(&list.getBack() == &b);
+	TEST_ASSERT_TRUE(list.remove(a));
+	TEST_ASSERT_TRUE(&list.getFront() == &b);
+	TEST_ASSERT_EQUALS(list.getSize(), 1u);
+
+	list.append(c);
+	list.append(d);
+	auto next = list.removeAfter(list.begin());
+	TEST_ASSERT_TRUE(next != list.end());
+	TEST_ASSERT_EQUALS(next->value, 4);
+	TEST_ASSERT_EQUALS(sum(list), 6);
+
+	next = list.removeAfter(list.begin());
+	TEST_ASSERT_TRUE(next == list.end());
+	TEST_ASSERT_TRUE(&list.getBack() == &b);
+	list.append(a);
+	TEST_ASSERT_EQUALS(sum(list), 3);
+}
+
+void
+IntrusiveListTest::testDoublyLinkedList()
+{
+	modm::IntrusiveDoublyLinkedList<Element> list;
+	TEST_ASSERT_TRUE(list.isEmpty());
+	TEST_ASSERT_TRUE(list.begin() == list.end());
+
+	Element a{1}, b{2}, c{3}, d{4};
+	list.append(b);
+	list.append(d);
+	list.prepend(a);
+	list.insert(++(++list.begin()), c);
+	TEST_ASSERT_EQUALS(list.getSize(), 4u);
+	TEST_ASSERT_TRUE(&list.getFront() == &a);
+	TEST_ASSERT_TRUE(&list.getBack() == &d);
+
+	int16_t expected{1};
+	for (const Element& element : list)
+	{
+		TEST_ASSERT_EQUALS(element.value, expected);
+		expected++;
+	}
+	// and backwards
+	auto it = list.end();
+	while (it != list.begin())
+	{
+		--it;
+		expected--;
+		TEST_ASSERT_EQUALS(it->value, expected);
+	}
+
+	list.removeBack();
+	list.removeFront();
+	TEST_ASSERT_TRUE(&list.getFront() == &b);
+	TEST_ASSERT_TRUE(&list.getBack() == &c);
+
+	it = list.erase(list.begin());
+	TEST_ASSERT_TRUE(&*it == &c);
+	TEST_ASSERT_EQUALS(list.getSize(), 1u);
+	list.removeAll();
+	TEST_ASSERT_TRUE(list.isEmpty());
+}
+
+void
+IntrusiveListTest::testDoublyLinkedListUnlink()
+{
+	modm::IntrusiveDoublyLinkedList<Element> list;
+	Element a{1}, b{2}, c{3};
+	list.append(a);
+	list.append(b);
+	list.append(c);
+
+	// any element can be removed in constant time
+	TEST_ASSERT_TRUE(static_cast<modm::IntrusiveDoublyLinkedListHook<>&>(b).isLinked());
+	list.remove(b);
+	TEST_ASSERT_FALSE(static_cast<modm::IntrusiveDoublyLinkedListHook<>&>(b).isLinked());
+	TEST_ASSERT_EQUALS(sum(list), 4);
+
+	// also without the list
+	static_cast<modm::IntrusiveDoublyLinkedListHook<>&>(c).unlink();
+	TEST_ASSERT_TRUE(&list.getBack() == &a);
+	TEST_ASSERT_EQUALS(list.getSize(), 1u);
+
+	// destroyed elements remove themselves
+	{
+		Element temporary{10};
+		list.append(temporary);
+		TEST_ASSERT_EQUALS(sum(list), 11);
+	}
+	TEST_ASSERT_EQUALS(sum(list), 1);
+
+	// copies are not linked
+	Element copy{a};
+	TEST_ASSERT_FALSE(static_cast<modm::IntrusiveDoublyLinkedListHook<>&>(copy).isLinked());
+	TEST_ASSERT_EQUALS(list.getSize(), 1u);
+
+	// destroying the list unlinks the elements
+	{
+		modm::IntrusiveDoublyLinkedList<Element> temporary;
+		temporary.append(b);
+	}
+	TEST_ASSERT_FALSE(static_cast<modm::IntrusiveDoublyLinkedListHook<>&>(b).isLinked());
+}
+
+void
+IntrusiveListTest::testMultipleHooks()
+{
+	modm::IntrusiveDoublyLinkedList<Element, ReadyTag> ready;
+	modm::IntrusiveDoublyLinkedList<Element, TimerTag> timers;
+	modm::IntrusiveList<Element> all;
+
+	Element a{1}, b{2};
+	ready.append(a);
+	ready.append(b);
+	timers.append(b);
+	all.append(b);
+	all.append(a);
+
+	TEST_ASSERT_EQUALS(ready.getSize(), 2u);
+	TEST_ASSERT_EQUALS(timers.getSize(), 1u);
+	TEST_ASSERT_TRUE(&all.getFront() == &b);
+
+	ready.remove(b);
+	TEST_ASSERT_TRUE(&ready.getFront() == &a);
+	TEST_ASSERT_TRUE(&timers.getFront() == &b);
+	TEST_ASSERT_EQUALS(all.getSize(), 2u);
+}
+
+void
+IntrusiveListTest::testBenchmark()
+{
+#ifdef MODM_OS_HOSTED
+	// Use the lists as a message queue of 32 messages. The intrusive lists
+	// must be faster than the lists, which allocate a node per message.
+	constexpr int16_t count = 32;
+	constexpr uint32_t operations = 200'000;
+	static Element elements[count];
+
+	// LinkedList copies the element into a node, IntrusiveList links it
+	const auto measure = [](auto& list)
+	{
+		for (int16_t ii = 0; ii < count; ii++) list.append(elements[ii]);
+		const auto start = std::chrono::steady_clock::now();
+		for (uint32_t ii = 0; ii < operations; ii++)
+		{
+			list.removeFront();
+			list.append(elements[ii % count]);
+		}
+		const auto diff = std::chrono::steady_clock::now() - start;
+		while (not list.isEmpty()) list.removeFront();
+		return std::chrono::duration<float, std::nano>(diff).count() / operations;
+	};
+	modm::LinkedList<Element> linked;
+	modm::IntrusiveList<Element> intrusive;
+	const float linked_cost = measure(linked);
+	const float intrusive_cost = measure(intrusive);
+	TEST_ASSERT_TRUE(intrusive_cost < linked_cost);
+
+	modm::DoublyLinkedList<Element> doubly_linked;
+	modm::IntrusiveDoublyLinkedList<Element> intrusive_doubly;
+	const float doubly_linked_cost = measure(doubly_linked);
+	const float intrusive_doubly_cost = measure(intrusive_doubly);
+	TEST_ASSERT_TRUE(intrusive_doubly_cost < doubly_linked_cost);
+#endif
+}
@@ -0,0 +1,247 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/container/smart_pointer.hpp>
+#include <cstring>
+#include <utility>
+
+#include "smart_pointer_test.hpp"
+
+namespace
+{
+	struct Small
+	{
+		uint32_t a;
+		uint16_t b;
+	};
+
+	struct Medium
+	{
+		uint8_t data[20];
+	};
+
+	struct Huge
+	{
+		uint8_t data[300];
+	};
+}
+
+void
+SmartPointerTest::testEmpty()
+{
+	const std::size_t allocated = modm::SmartPointer::getNumberOfAllocatedPayloads();
+
+	modm::SmartPointer empty;
+	TEST_ASSERT_EQUALS(empty.getSize(), 0U);
+	TEST_ASSERT_TRUE(empty == modm::SmartPointer());
+	TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated);
+}
+
+void
+SmartPointerTest::testInline()
+{
+	const std::size_t allocated = modm::SmartPointer::getNumberOfAllocatedPayloads();
+
+	Small small{0x12345678, 0xabcd};
+	modm::SmartPointer ptr(&small);
+	TEST_ASSERT_EQUALS(ptr.getSize(), sizeof(Small));
+	TEST_ASSERT_EQUALS(ptr.get<Small>().a, 0x12345678U);
+	TEST_ASSERT_EQUALS(ptr.get<Small>().b, 0xabcd);
+
+	modm::SmartPointer copy(ptr);
+	TEST_ASSERT_EQUALS(copy.get<Small>().a, 0x12345678U);
+
+	uint64_t largest = 0x0102030405060708;
+	modm::SmartPointer ptr8(&largest);
+	TEST_ASSERT_EQUALS(ptr8.get<uint64_t>(), largest);
+
+	if constexpr (modm::SmartPointer::InlineSize >= sizeof(uint64_t))
+	{
+		// small payloads are stored by value
+		TEST_ASSERT_TRUE(copy.getPointer() != ptr.getPointer());
+		TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated);
+	}
+	else
+	{
+		TEST_ASSERT_TRUE(copy.getPointer() == ptr.getPointer());
+		TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated + 2);
+	}
+}
+
+void
+SmartPointerTest::testPooled()
+{
+	const std::size_t allocated = modm::SmartPointer::getNumberOfAllocatedPayloads();
+	{
+		Medium medium;
+		for (uint8_t i = 0; i < sizeof(medium.data); ++i) {
+			medium.data[i] = i;
+		}
+
+		modm::SmartPointer ptr(&medium);
+		TEST_ASSERT_EQUALS(ptr.getSize(), sizeof(Medium));
+		TEST_ASSERT_EQUALS_ARRAY(ptr.getPointer(), medium.data, sizeof(medium.data));
+		TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated + 1);
+
+		Medium result;
+		TEST_ASSERT_TRUE(ptr.get(result));
+		TEST_ASSERT_EQUALS_ARRAY(result.data, medium.data, sizeof(medium.data));
+
+		Small wrong;
+		TEST_ASSERT_FALSE(ptr.get(wrong));
+
+		// payloads of different size classes
+		modm::SmartPointer ptr9(uint16_t(9));
+		modm::SmartPointer ptr40(uint16_t(40));
+		modm::SmartPointer ptr100(uint16_t(100));
+		modm::SmartPointer ptr124(uint16_t(124));
+		TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated + 5);
+	}
+	TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated);
+}
+
+void
+SmartPointerTest::testLarge()
+{
+	const std::size_t allocated = modm::SmartPointer::getNumberOfAllocatedPayloads();
+	{
+		Huge huge;
+		for (uint16_t i = 0; i < sizeof(huge.data); ++i) {
+			huge.data[i] = i;
+		}
+
+		modm::SmartPointer ptr(&huge);
+		modm::SmartPointer copy(ptr);
+		TEST_ASSERT_EQUALS(copy.getSize(), sizeof(Huge));
+		TEST_ASSERT_EQUALS_ARRAY(copy.getPointer(), huge.data, sizeof(huge.data));
+		TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated + 1);
+	}
+	TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated);
+}
+
+void
+SmartPointerTest::testCopy()
+{
+	const std::size_t allocated = modm::SmartPointer::getNumberOfAllocatedPayloads();
+	{
+		modm::SmartPointer ptr(uint16_t(20));
+		ptr.getPointer()[0] = 42;
+		{
+			// larger payloads are shared between the copies
+			modm::SmartPointer copy(ptr);
+			TEST_ASSERT_TRUE(copy.getPointer() == ptr.getPointer());
+			TEST_ASSERT_EQUALS(copy.getPointer()[0], 42);
+		}
+		TEST_ASSERT_EQUALS(ptr.getPointer()[0], 42);
+		TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated + 1);
+	}
+	TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated);
+}
+
+void
+SmartPointerTest::testMove()
+{
+	const std::size_t allocated = modm::SmartPointer::getNumberOfAllocatedPayloads();
+	{
+		modm::SmartPointer ptr(uint16_t(20));
+		const uint8_t* payload = ptr.getPointer();
+
+		modm::SmartPointer moved(std::move(ptr));
+		TEST_ASSERT_EQUALS(moved.getSize(), 20U);
+		TEST_ASSERT_TRUE(moved.getPointer() == payload);
+		TEST_ASSERT_EQUALS(ptr.getSize(), 0U);
+
+		modm::SmartPointer assigned;
+		assigned = std::move(moved);
+		TEST_ASSERT_TRUE(assigned.getPointer() == payload);
+		TEST_ASSERT_EQUALS(moved.getSize(), 0U);
+		TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated + 1);
+
+		Small small{1, 2};
+		modm::SmartPointer inlined(&small);
+		assigned = std::move(inlined);
+		TEST_ASSERT_EQUALS(assigned.get<Small>().b, 2);
+		TEST_ASSERT_EQUALS(inlined.getSize(), 0U);
+		TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(),
+						   allocated + (sizeof(Small) > modm::SmartPointer::InlineSize ? 1 : 0));
+	}
+	TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated);
+}
+
+void
+SmartPointerTest::testAssignment()
+{
+	const std::size_t allocated = modm::SmartPointer::getNumberOfAllocatedPayloads();
+	{
+		modm::SmartPointer a(uint16_t(20));
+		modm::SmartPointer b(uint16_t(50));
+		TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated + 2);
+
+		a = b;
+		TEST_ASSERT_TRUE(a.getPointer() == b.getPointer());
+		TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated + 1);
+
+		// self assignment must not release the payload
+		modm::SmartPointer& self = a;
+		a = self;
+		TEST_ASSERT_EQUALS(a.getSize(), 50U);
+		TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated + 1);
+
+		b = modm::SmartPointer();
+		TEST_ASSERT_EQUALS(a.getSize(), 50U);
+		TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated + 1);
+	}
+	TEST_ASSERT_EQUALS(modm::SmartPointer::getNumberOfAllocatedPayloads(), allocated);
+}
+
+void
+SmartPointerTest::testEquality()
+{
+	TEST_ASSERT_TRUE(modm::SmartPointer() == modm::SmartPointer());
+
+	Medium medium{};
+	modm::SmartPointer a(&medium);
+	modm::SmartPointer b(&medium);
+	// pointers are only equal if they share the payload
+	TEST_ASSERT_FALSE(a == b);
+	TEST_ASSERT_FALSE(a == modm::SmartPointer());
+
+	modm::SmartPointer copy(a);
+	TEST_ASSERT_TRUE(copy == a);
+
+	copy = b;
+	TEST_ASSERT_TRUE(copy == b);
+	TEST_ASSERT_FALSE(copy == a);
+}
+
+void
+SmartPointerTest::testCopySemantics()
+{
+	constexpr uint16_t inlineSize = modm::SmartPointer::InlineSize;
+	if constexpr (inlineSize > 0)
+	{
+		// small payloads are copied, so later changes are not visible in the copy
+		modm::SmartPointer small(inlineSize);
+		std::memset(small.getPointer(), 1, inlineSize);
+		const modm::SmartPointer copy(small);
+		TEST_ASSERT_EQUALS(copy.getPointer()[0], 1);
+		TEST_ASSERT_FALSE(copy == small);
+
+		small.getPointer()[0] = 2;
+		TEST_ASSERT_EQUALS(copy.getPointer()[0], 1);
+	}
+
+	// larger payloads are shared, so changes are visible in all copies
+	modm::SmartPointer large(uint16_t(inlineSize + 1));
+	std::memset(large.getPointer(), 1, inlineSize + 1);
+	const modm::SmartPointer copy(large);
+	large.getPointer()[0] = 2;
+	TEST_ASSERT_EQUALS(copy.getPointer()[0], 2);
+	TEST_ASSERT_TRUE(copy == large);
+}
@@ -0,0 +1,290 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/container/static_hash_map.hpp>
+
+#include "static_hash_map_test.hpp"
+
+#ifdef MODM_OS_HOSTED
+#include <chrono>
+#include <map>
+#endif
+
+namespace
+{
+
+int16_t
+twice(int16_t value)
+{ return 2 * value; }
+
+int16_t
+negate(int16_t value)
+{ return -value; }
+
+constexpr modm::StaticHashMap<uint8_t, int16_t(*)(int16_t), 8> handlers{
+	{0x10, twice}, {0x20, negate},
+};
+
+// the map is constructed at compile time
+constexpr modm::StaticHashMap<uint16_t, uint16_t, 5> squares{
+	{1, 1}, {2, 4}, {3, 9}, {4, 16}, {5, 25},
+};
+static_assert(squares.getSize() == 5);
+static_assert(squares.isFull());
+static_assert(*squares.find(4) == 16);
+static_assert(squares.find(6) == nullptr);
+
+/// Pseudo random numbers, which are the same on every target
+uint16_t
+nextRandom()
+{
+	static uint32_t state = 12345;
+	state = state * 1103515245ul + 12345ul;
+	return state >> 16;
+}
+
+}
+
+void
+StaticHashMapTest::testInsertFind()
+{
+	modm::StaticHashMap<uint8_t, int16_t, 10> map;
+
+	TEST_ASSERT_TRUE(map.isEmpty());
+	TEST_ASSERT_EQUALS(map.getMaxSize(), 10U);
+	TEST_ASSERT_TRUE(map.find(1) == nullptr);
+
+	TEST_ASSERT_TRUE(map.insert(1, 100));
+	TEST_ASSERT_TRUE(map.insert(2, 200));
+	TEST_ASSERT_TRUE(map.insert(12, -12));
+
+	// the map does not insert the same key twice
+	TEST_ASSERT_FALSE(map.insert(2, 300));
+
+	TEST_ASSERT_EQUALS(map.getSize(), 3U);
+	TEST_ASSERT_EQUALS(*map.find(1), 100);
+	TEST_ASSERT_EQUALS(*map.find(2), 200);
+	TEST_ASSERT_EQUALS(*map.find(12), -12);
+	TEST_ASSERT_TRUE(map.find(3) == nullptr);
+	TEST_ASSERT_TRUE(map.contains(12));
+	TEST_ASSERT_FALSE(map.contains(13));
+	TEST_ASSERT_EQUALS(map.count(1), 1U);
+	TEST_ASSERT_EQUALS(map.count(3), 0U);
+
+	TEST_ASSERT_TRUE(map.insertOrAssign(2, 300));
+	TEST_ASSERT_EQUALS(*map.find(2), 300);
+	TEST_ASSERT_EQUALS(map.getSize(), 3U);
+
+	*map.find(1) = 101;
+	TEST_ASSERT_EQUALS(*map.find(1), 101);
+
+	map.clear();
+	TEST_ASSERT_TRUE(map.isEmpty());
+	TEST_ASSERT_TRUE(map.find(1) == nullptr);
+}
+
+void
+StaticHashMapTest::testRemove()
+{
+	// all keys have the same home slot in a map of size one
+	modm::StaticHashMap<uint8_t, int16_t, 4> map;
+	for (uint8_t key = 0; key < 4; ++key) {
+		TEST_ASSERT_TRUE(map.insert(key * 4, key));
+	}
+
+	TEST_ASSERT_EQUALS(map.remove(4), 1U);
+	TEST_ASSERT_EQUALS(map.remove(4), 0U);
+	TEST_ASSERT_EQUALS(map.getSize(), 3U);
+
+	// the following entries are still found after removing an entry
+	TEST_ASSERT_EQUALS(*map.find(0), 0);
+	TEST_ASSERT_EQUALS(*map.find(8), 2);
+	TEST_ASSERT_EQUALS(*map.find(12), 3);
+
+	TEST_ASSERT_TRUE(map.insert(4, 5));
+	TEST_ASSERT_EQUALS(*map.find(4), 5);
+	TEST_ASSERT_TRUE(map.isFull());
+}
+
+void
+StaticHashMapTest::testFull()
+{
+	modm::StaticHashMap<uint16_t, uint16_t, 3> map;
+	TEST_ASSERT_TRUE(map.insert(1, 1));
+	TEST_ASSERT_TRUE(map.insert(2, 2));
+	TEST_ASSERT_TRUE(map.insert(3, 3));
+	TEST_ASSERT_TRUE(map.isFull());
+
+	TEST_ASSERT_FALSE(map.insert(4, 4));
+	TEST_ASSERT_FALSE(map.insertOrAssign(4, 4));
+	TEST_ASSERT_TRUE(map.insertOrAssign(3, 30));
+
+	// a lookup in a full map terminates
+	TEST_ASSERT_TRUE(map.find(4) == nullptr);
+	TEST_ASSERT_EQUALS(*map.find(3), 30);
+
+	modm::StaticHashMap<uint8_t, uint8_t, 1> one;
+	TEST_ASSERT_TRUE(one.insert(7, 1));
+	TEST_ASSERT_FALSE(one.insert(8, 1));
+	TEST_ASSERT_TRUE(one.find(8) == nullptr);
+	TEST_ASSERT_EQUALS(one.remove(7), 1U);
+	TEST_ASSERT_TRUE(one.isEmpty());
+}
+
+void
+StaticHashMapTest::testConstexpr()
+{
+	TEST_ASSERT_EQUALS((*handlers.find(0x10))(21), 42);
+	TEST_ASSERT_EQUALS((*handlers.find(0x20))(21), -21);
+	TEST_ASSERT_TRUE(handlers.find(0x30) == nullptr);
+
+	TEST_ASSERT_EQUALS(*squares.find(5), 25);
+}
+
+void
+StaticHashMapTest::testIterator()
+{
+	modm::StaticHashMap<uint8_t, uint16_t, 16> map{{1, 10}, {2, 20}, {3, 30}};
+
+	uint16_t sum = 0;
+	uint8_t count = 0;
+	for (const auto& entry : map)
+	{
+		TEST_ASSERT_EQUALS(entry.value, entry.key * 10);
+		sum += entry.value;
+		count++;
+	}
+	TEST_ASSERT_EQUALS(count, 3U);
+	TEST_ASSERT_EQUALS(sum, 60U);
+
+	for (auto& entry : map) {
+		entry.value++;
+	}
+	TEST_ASSERT_EQUALS(*map.find(2), 21U);
+
+	const modm::StaticHashMap<uint8_t, uint16_t, 16> empty;
+	TEST_ASSERT_TRUE(empty.begin() == empty.end());
+}
+
+void
+StaticHashMapTest::testMultiMap()
+{
+	modm::StaticHashMultiMap<uint8_t, int16_t, 8> map;
+
+	TEST_ASSERT_TRUE(map.insert(1, 10));
+	TEST_ASSERT_TRUE(map.insert(1, 11));
+	TEST_ASSERT_TRUE(map.insert(9, 90));
+	TEST_ASSERT_TRUE(map.insert(1, 12));
+
+	TEST_ASSERT_EQUALS(map.getSize(), 4U);
+	TEST_ASSERT_EQUALS(map.count(1), 3U);
+	TEST_ASSERT_EQUALS(map.count(9), 1U);
+	TEST_ASSERT_EQUALS(map.count(2), 0U);
+
+	int16_t sum = 0;
+	map.forEach(1, [&sum](int16_t value) { sum += value; });
+	TEST_ASSERT_EQUALS(sum, 33);
+
+	map.forEach(1, [](int16_t& value) { value = 0; });
+	sum = 0;
+	map.forEach(1, [&sum](int16_t value) { sum += value; });
+	TEST_ASSERT_EQUALS(sum, 0);
+
+	TEST_ASSERT_EQUALS(map.remove(1), 3U);
+	TEST_ASSERT_EQUALS(map.getSize(), 1U);
+	TEST_ASSERT_EQUALS(map.count(1), 0U);
+	TEST_ASSERT_EQUALS(map.count(9), 1U);
+}
+
+void
+StaticHashMapTest::testRandom()
+{
+	// compare against a naive map, which stores every key at its index
+	constexpr uint16_t keys = 64;
+	int16_t reference[keys];
+	bool exists[keys] = {};
+
+	modm::StaticHashMap<uint16_t, int16_t, 40> map;
+	for (uint16_t ii = 0; ii < 2000; ++ii)
+	{
+		const uint16_t key = nextRandom() % keys;
+		const int16_t value = nextRandom();
+		switch (nextRandom() % 3)
+		{
+			case 0:
+				TEST_ASSERT_EQUALS(map.insert(key, value), not exists[key] and not map.isFull());
+				if (not exists[key] and map.find(key)) {
+					exists[key] = true;
+					reference[key] = value;
+				}
+				break;
+			case 1:
+				TEST_ASSERT_EQUALS(map.remove(key), exists[key] ? 1U : 0U);
+				exists[key] = false;
+				break;
+			default:
+				break;
+		}
+
+		uint8_t size = 0;
+		for (uint16_t k = 0; k < keys; ++k)
+		{
+			if (exists[k]) {
+				size++;
+				TEST_ASSERT_TRUE(map.find(k) != nullptr and *map.find(k) == reference[k]);
+			}
+			else {
+				TEST_ASSERT_TRUE(map.find(k) == nullptr);
+			}
+		}
+		TEST_ASSERT_EQUALS(map.getSize(), size);
+	}
+}
+
+void
+StaticHashMapTest::testBenchmark()
+{
+#ifdef MODM_OS_HOSTED
+	// Look up packet handlers by their 8-bit identifier, like a postman. The
+	// hash map must be faster than the tree of the std::map.
+	constexpr uint32_t lookups = 1'000'000;
+	constexpr uint8_t entries = 48;
+
+	std::map<uint8_t, uint32_t> tree;
+	modm::StaticHashMap<uint8_t, uint32_t, 64> hash;
+	for (uint8_t ii = 0; ii < entries; ++ii)
+	{
+		tree[ii * 5] = ii;
+		hash.insert(ii * 5, ii);
+	}
+
+	const auto measure = [](auto&& lookup)
+	{
+		uint32_t sum = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (uint32_t ii = 0; ii < lookups; ii++) {
+			sum += lookup(uint8_t(ii * 7));
+		}
+		const auto diff = std::chrono::steady_clock::now() - start;
+		return std::make_pair(std::chrono::duration<float, std::nano>(diff).count() / lookups, sum);
+	};
+	const auto [tree_cost, tree_sum] = measure([&tree](uint8_t key)
+	{
+		auto it = tree.find(key);
+		return (it != tree.end()) ? it->second : 0;
+	});
+	const auto [hash_cost, hash_sum] = measure([&hash](uint8_t key)
+	{
+		const uint32_t* value = hash.find(key);
+		return value ? *value : 0;
+	});
+	TEST_ASSERT_EQUALS(tree_sum, hash_sum);
+	TEST_ASSERT_TRUE(hash_cost < tree_cost);
+#endif
+}
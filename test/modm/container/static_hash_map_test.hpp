@@ -0,0 +1,40 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <unittest/testsuite.hpp>
+
+/// @ingroup modm_test_test_container
+class StaticHashMapTest : public unittest::TestSuite
+{
+public:
+	void
+	testInsertFind();
+
+	void
+	testRemove();
+
+	void
+	testFull();
+
+	void
+	testConstexpr();
+
+	void
+	testIterator();
+
+	void
+	testMultiMap();
+
+	// Random operations must give the same result as a std::map
+	void
+	testRandom();
+
+	void
+	testBenchmark();
+};
@@ -0,0 +1,182 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/container/static_sorted_vector.hpp>
+
+#include "static_sorted_vector_test.hpp"
+
+namespace
+{
+
+struct Entry
+{
+	uint8_t key;
+	uint8_t value;
+};
+
+struct ByKey
+{
+	constexpr bool
+	operator()(const Entry& a, const Entry& b) const
+	{ return a.key < b.key; }
+};
+
+constexpr modm::StaticSortedVector<uint8_t, 8>
+squares()
+{
+	modm::StaticSortedVector<uint8_t, 8> vector;
+	for (uint8_t value : {25, 1, 16, 4, 9}) vector.insert(value);
+	return vector;
+}
+
+/// Pseudo random numbers, which are the same on every target
+uint16_t
+nextRandom()
+{
+	static uint32_t state = 12345;
+	state = state * 1103515245ul + 12345ul;
+	return state >> 16;
+}
+
+}
+
+void
+StaticSortedVectorTest::testInsert()
+{
+	modm::StaticSortedVector<int16_t, 8> vector;
+	TEST_ASSERT_TRUE(vector.isEmpty());
+	TEST_ASSERT_EQUALS(vector.getMaxSize(), 8U);
+
+	for (int16_t value : {5, -3, 12, 0, 5}) {
+		TEST_ASSERT_TRUE(vector.insert(value));
+	}
+	TEST_ASSERT_EQUALS(vector.getSize(), 5U);
+
+	const int16_t expected[] = {-3, 0, 5, 5, 12};
+	TEST_ASSERT_EQUALS_ARRAY(vector.begin(), expected, 5);
+	TEST_ASSERT_EQUALS(vector[1], 0);
+	TEST_ASSERT_EQUALS(vector.getFront(), -3);
+	TEST_ASSERT_EQUALS(vector.getBack(), 12);
+
+	uint8_t count = 0;
+	for (int16_t value : vector) {
+		TEST_ASSERT_EQUALS(value, expected[count++]);
+	}
+	TEST_ASSERT_EQUALS(count, 5);
+}
+
+void
+StaticSortedVectorTest::testFind()
+{
+	modm::StaticSortedVector<uint16_t, 16> vector;
+	for (uint16_t value : {100, 20, 300, 20, 40}) vector.insert(value);
+
+	TEST_ASSERT_TRUE(vector.contains(300));
+	TEST_ASSERT_FALSE(vector.contains(30));
+	TEST_ASSERT_FALSE(vector.contains(500));
+	TEST_ASSERT_TRUE(vector.find(10) == nullptr);
+
+	const uint16_t* found = vector.find(20);
+	TEST_ASSERT_TRUE(found == vector.begin());
+	TEST_ASSERT_EQUALS(vector.count(20), 2U);
+	TEST_ASSERT_EQUALS(vector.count(21), 0U);
+
+	TEST_ASSERT_EQUALS(vector.lowerBound(40), 2U);
+	TEST_ASSERT_EQUALS(vector.upperBound(40), 3U);
+	TEST_ASSERT_EQUALS(vector.lowerBound(1000), 5U);
+}
+
+void
+StaticSortedVectorTest::testRemove()
+{
+	modm::StaticSortedVector<uint8_t, 8> vector;
+	for (uint8_t value : {4, 2, 8, 2, 6}) vector.insert(value);
+
+	TEST_ASSERT_EQUALS(vector.remove(2), 2U);
+	TEST_ASSERT_EQUALS(vector.remove(3), 0U);
+	TEST_ASSERT_EQUALS(vector.getSize(), 3U);
+	TEST_ASSERT_EQUALS(vector.getFront(), 4);
+
+	vector.removeAt(1);
+	TEST_ASSERT_EQUALS(vector.getSize(), 2U);
+	TEST_ASSERT_EQUALS(vector[0], 4);
+	TEST_ASSERT_EQUALS(vector[1], 8);
+
+	vector.removeBack();
+	TEST_ASSERT_EQUALS(vector.getBack(), 4);
+	vector.removeFront();
+	TEST_ASSERT_TRUE(vector.isEmpty());
+}
+
+void
+StaticSortedVectorTest::testFull()
+{
+	modm::StaticSortedVector<uint8_t, 3> vector;
+	TEST_ASSERT_TRUE(vector.insert(3));
+	TEST_ASSERT_TRUE(vector.insert(1));
+	TEST_ASSERT_TRUE(vector.insert(2));
+	TEST_ASSERT_TRUE(vector.isFull());
+
+	TEST_ASSERT_FALSE(vector.insert(0));
+	TEST_ASSERT_EQUALS(vector.getFront(), 1);
+
+	vector.clear();
+	TEST_ASSERT_TRUE(vector.isEmpty());
+	TEST_ASSERT_TRUE(vector.insert(7));
+}
+
+void
+StaticSortedVectorTest::testStable()
+{
+	modm::StaticSortedVector<Entry, 8, ByKey> vector;
+	vector.insert({2, 0});
+	vector.insert({1, 1});
+	vector.insert({2, 2});
+	vector.insert({1, 3});
+	vector.insert({2, 4});
+
+	// equal keys keep the order of insertion
+	const uint8_t expected[] = {1, 3, 0, 2, 4};
+	for (uint8_t ii = 0; ii < 5; ++ii) {
+		TEST_ASSERT_EQUALS(vector[ii].value, expected[ii]);
+	}
+	TEST_ASSERT_EQUALS(vector.find({2, 0xff})->value, 0);
+}
+
+void
+StaticSortedVectorTest::testConstexpr()
+{
+	constexpr auto vector = squares();
+	static_assert(vector.getSize() == 5);
+	static_assert(vector.getFront() == 1);
+	static_assert(vector.getBack() == 25);
+	static_assert(vector.contains(16));
+	static_assert(not vector.contains(15));
+	TEST_ASSERT_EQUALS(vector[2], 9);
+}
+
+void
+StaticSortedVectorTest::testRandom()
+{
+	modm::StaticSortedVector<uint16_t, 100> vector;
+	for (uint16_t round = 0; round < 300; ++round)
+	{
+		const uint16_t value = nextRandom() % 200;
+		if (nextRandom() % 3) {
+			vector.insert(value);
+		} else {
+			vector.remove(value);
+		}
+	}
+	TEST_ASSERT_TRUE(vector.isNotEmpty());
+
+	for (uint8_t ii = 1; ii < vector.getSize(); ++ii) {
+		TEST_ASSERT_TRUE(vector[ii - 1] <= vector[ii]);
+	}
+}
@@ -0,0 +1,175 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/io/format.hpp>
+#include <modm-test/mock/iodevice.hpp>
+#include <modm-test/mock/io_device.hpp>
+#include <limits>
+#include <string_view>
+
+#include "format_test.hpp"
+
+// ----------------------------------------------------------------------------
+static modm_test::platform::IODevice device;
+static modm::IOStream stream(device);
+
+// the buffer of the device is cleared with zeros
+#define TEST_ASSERT_OUTPUT(expected) \
+	TEST_ASSERT_EQUALS_STRING(device.buffer, expected); \
+	TEST_ASSERT_EQUALS(device.bytesWritten, sizeof(expected) - 1)
+
+void
+FormatTest::setUp()
+{
+	device.clear();
+}
+
+// ----------------------------------------------------------------------------
+void
+FormatTest::testLiterals()
+{
+	modm::format<"">(stream);
+	TEST_ASSERT_EQUALS(device.bytesWritten, 0U);
+
+	modm::format<"abc d ">(stream);
+	TEST_ASSERT_OUTPUT("abc d ");
+}
+
+void
+FormatTest::testEscapedBraces()
+{
+	modm::format<"{{{}}} }}{{">(stream, 5);
+	TEST_ASSERT_OUTPUT("{5} }{");
+}
+
+void
+FormatTest::testIntegers()
+{
+	modm::format<"x={} y={:08x} z={:X} b={:b} o={:o} d={:d}">(stream, -12, 0xbeefu, 0xbeef, 5, 8, 42);
+	TEST_ASSERT_OUTPUT("x=-12 y=0000beef z=BEEF b=101 o=10 d=42");
+}
+
+void
+FormatTest::testIntegerLimits()
+{
+	modm::format<"{} {} {} {}">(stream,
+			std::numeric_limits<int32_t>::min(), std::numeric_limits<uint32_t>::max(),
+			std::numeric_limits<int64_t>::min(), std::numeric_limits<uint64_t>::max());
+	TEST_ASSERT_OUTPUT("-2147483648 4294967295 -9223372036854775808 18446744073709551615");
+
+	device.clear();
+	modm::format<"{:b}">(stream, std::numeric_limits<uint64_t>::max());
+	TEST_ASSERT_EQUALS(device.bytesWritten, 64U);
+
+	device.clear();
+	modm::format<"{} {}">(stream, 0, std::numeric_limits<int8_t>::min());
+	TEST_ASSERT_OUTPUT("0 -128");
+}
+
+void
+FormatTest::testIntegerTypes()
+{
+	modm::format<"{} {} {} {} {}">(stream, uint8_t(200), int8_t(-100), uint16_t(60000),
+			int16_t(-30000), 123456789l);
+	TEST_ASSERT_OUTPUT("200 -100 60000 -30000 123456789");
+}
+
+void
+FormatTest::testWidthAndAlignment()
+{
+	modm::format<"[{:5}][{:<5}][{:^5}][{:*>6}][{:2}]">(stream, 42, 42, 42, 42, 12345);
+	TEST_ASSERT_OUTPUT("[   42][42   ][ 42  ][****42][12345]");
+
+	device.clear();
+	modm::format<"[{:05}][{:06x}][{:<05}]">(stream, -42, 0xab, 7);
+	TEST_ASSERT_OUTPUT("[-0042][0000ab][7    ]");
+}
+
+void
+FormatTest::testSignAndPrefix()
+{
+	modm::format<"{:+} {:+} {:#x} {:#X} {:#b} {:#o} {:#010x}">(stream, 5, -5, 255, 255, 5, 8, 255);
+	TEST_ASSERT_OUTPUT("+5 -5 0xff 0XFF 0b101 010 0x000000ff");
+}
+
+void
+FormatTest::testCharacters()
+{
+	modm::format<"{}{:c}{:>3}|{:d}|{:x}">(stream, 'a', 66, 'c', 'A', 'A');
+	TEST_ASSERT_OUTPUT("aB  c|65|41");
+}
+
+void
+FormatTest::testStrings()
+{
+	const char* pointer = "abc";
+	const char array[] = "def";
+	const std::string_view view("ghijk", 3);
+	modm::format<"{} {:s} {} [{:5}] [{:>5}] [{:^7}]">(stream, pointer, array, view, "ab", "ab", "ab");
+	TEST_ASSERT_OUTPUT("abc def ghi [ab   ] [   ab] [  ab   ]");
+}
+
+void
+FormatTest::testBooleans()
+{
+	modm::format<"{} {} [{:>6}]">(stream, true, false, true);
+	TEST_ASSERT_OUTPUT("true false [  true]");
+}
+
+void
+FormatTest::testPointers()
+{
+	const void* pointer = reinterpret_cast<const void*>(0x1234);
+	modm::format<"{} {:p}">(stream, pointer, nullptr);
+	TEST_ASSERT_OUTPUT("0x1234 0x0");
+}
+
+namespace
+{
+enum class
+Color : uint8_t
+{
+	Red = 1,
+	Blue = 200,
+};
+}
+
+void
+FormatTest::testEnums()
+{
+	modm::format<"{} {:x}">(stream, Color::Red, Color::Blue);
+	TEST_ASSERT_OUTPUT("1 c8");
+}
+
+void
+FormatTest::testLongOutput()
+{
+	// longer than the buffer of the stream
+	modm::format<"0123456789012345678901234567890123456789 {:>40} end">(stream, "x");
+	TEST_ASSERT_OUTPUT("0123456789012345678901234567890123456789 "
+					   "                                       x end");
+}
+
+// ----------------------------------------------------------------------------
+void
+FormatTest::testBlockWrites()
+{
+	using FakeIODevice = modm_test::FakeIODevice;
+	modm::IODeviceWrapper<FakeIODevice, modm::IOBuffer::BlockIfFull> wrapper;
+	modm::IOStream blockStream(wrapper);
+	FakeIODevice::reset();
+
+	// short output is written with a single call of the device
+	modm::format<"x={} y={:04x}\n">(blockStream, -1, 0x2a);
+
+	const uint8_t expected[] = "x=-1 y=002a\n";
+	TEST_ASSERT_EQUALS(FakeIODevice::bytesSend, sizeof(expected) - 1);
+	TEST_ASSERT_EQUALS_ARRAY(expected, FakeIODevice::sendBuffer, sizeof(expected) - 1);
+	TEST_ASSERT_EQUALS(FakeIODevice::writeCalls, 1U);
+}
@@ -0,0 +1,60 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <unittest/testsuite.hpp>
+
+/// @ingroup modm_test_test_io
+class FormatTest : public unittest::TestSuite
+{
+public:
+	void
+	setUp() override;
+
+	void
+	testLiterals();
+
+	void
+	testEscapedBraces();
+
+	void
+	testIntegers();
+
+	void
+	testIntegerLimits();
+
+	void
+	testIntegerTypes();
+
+	void
+	testWidthAndAlignment();
+
+	void
+	testSignAndPrefix();
+
+	void
+	testCharacters();
+
+	void
+	testStrings();
+
+	void
+	testBooleans();
+
+	void
+	testPointers();
+
+	void
+	testEnums();
+
+	void
+	testLongOutput();
+
+	void
+	testBlockWrites();
+};
@@ -0,0 +1,293 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <modm/io/format.hpp>
+#include <modm/debug/logger.hpp>
+#include <modm-test/mock/io_device.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include "io_stream_benchmark_test.hpp"
+
+// The mock clock replaces the modm clocks, so the benchmark uses the host clock
+#ifdef MODM_OS_HOSTED
+#include <chrono>
+#if defined(__x86_64__) or defined(__i386__)
+#	include <x86intrin.h>
+#endif
+
+/*
+ * Every measurement prints one line of space separated key=value pairs in
+ * this order, the time is the average of writing one line:
+ *
+ * iostream-benchmark device=block op=integers bytes=22 calls=6
+ *     time=85.20 unit=ns throughput=258.21 unit=MB/s
+ *
+ * - bytes: number of characters in the line
+ * - calls: number of calls of the device per line
+ *
+ * The comparison of the formatting functions prints the average time of one
+ * call in cycles of the time stamp counter on x86, otherwise in nanoseconds:
+ *
+ * format-benchmark op=format bytes=22 calls=1 time=120.50 unit=cycles
+ */
+namespace
+{
+
+constexpr uint32_t rounds = 10000;
+
+using FakeIODevice = modm_test::FakeIODevice;
+
+/// Measures nanoseconds
+struct Stopwatch
+{
+	Stopwatch() :
+		start(std::chrono::steady_clock::now())
+	{
+	}
+
+	uint64_t
+	elapsed() const
+	{
+		const auto diff = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(diff).count();
+	}
+
+	std::chrono::steady_clock::time_point start;
+};
+
+/// Measures cycles of the time stamp counter or nanoseconds
+struct CycleCounter
+{
+#if defined(__x86_64__) or defined(__i386__)
+	static constexpr const char* unit = "cycles";
+
+	static uint64_t
+	now()
+	{ return __rdtsc(); }
+#else
+	static constexpr const char* unit = "ns";
+
+	static uint64_t
+	now()
+	{
+		const auto time = std::chrono::steady_clock::now().time_since_epoch();
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+	}
+#endif
+
+	uint64_t
+	elapsed() const
+	{ return now() - start; }
+
+	uint64_t start{now()};
+};
+
+/// Writes every character on its own, like a device without block writes
+class CharacterDevice : public modm::IODevice
+{
+public:
+	using modm::IODevice::write;
+
+	void
+	write(char c) override
+	{
+		FakeIODevice::write(uint8_t(c));
+	}
+
+	void
+	flush() override
+	{
+	}
+
+	bool
+	read(char&) override
+	{
+		return false;
+	}
+};
+
+/// Forwards blocks of characters to FakeIODevice::write(const uint8_t*, size_t)
+using BlockDevice = modm::IODeviceWrapper<FakeIODevice, modm::IOBuffer::BlockIfFull>;
+
+/// Prints a number with two decimal places without floating point support
+void
+printFixed(uint64_t value)
+{
+	MODM_LOG_INFO << uint32_t(value / 100) << '.' << ((value % 100) < 10 ? "0" : "")
+				  << uint32_t(value % 100);
+}
+
+/**
+ * Writes one line `rounds` times with `function(stream)`.
+ *
+ * @return the number of device calls for one line
+ */
+template< typename Device, typename Function >
+std::size_t
+benchmark(const char* name, const char* op, const char* expected, Function&& function)
+{
+	Device device;
+	modm::IOStream stream(device);
+
+	// the first line checks the output and warms up the caches
+	FakeIODevice::reset();
+	function(stream);
+	const std::size_t bytes = FakeIODevice::bytesWritten;
+	const std::size_t calls = FakeIODevice::writeCalls;
+	TEST_ASSERT_EQUALS(bytes, std::strlen(expected));
+	TEST_ASSERT_EQUALS(std::memcmp(FakeIODevice::sendBuffer, expected,
+			std::min(bytes, sizeof(FakeIODevice::sendBuffer))), 0);
+
+	Stopwatch stopwatch;
+	for (uint32_t ii = 0; ii < rounds; ii++) {
+		function(stream);
+	}
+	const uint64_t time = std::max<uint64_t>(stopwatch.elapsed(), 1);
+	TEST_ASSERT_EQUALS(FakeIODevice::bytesWritten, bytes * (rounds + 1));
+
+	MODM_LOG_INFO << "iostream-benchmark device=" << name
+				  << " op=" << op
+				  << " bytes=" << uint32_t(bytes)
+				  << " calls=" << uint32_t(calls)
+				  << " time=";
+	printFixed(time * 100 / rounds);
+	MODM_LOG_INFO << " unit=ns throughput=";
+	// bytes per nanosecond are thousand megabytes per second
+	printFixed(uint64_t(bytes) * rounds * 100'000 / time);
+	MODM_LOG_INFO << " unit=MB/s" << modm::endl;
+	return calls;
+}
+
+template< typename Function >
+void
+compare(const char* op, const char* expected, Function&& function)
+{
+	const std::size_t characterCalls = benchmark<CharacterDevice>("character", op, expected, function);
+	const std::size_t blockCalls = benchmark<BlockDevice>("block", op, expected, function);
+	TEST_ASSERT_TRUE(blockCalls < characterCalls);
+}
+
+/// Writes one line `rounds` times with `function(stream)` to the block device
+template< typename Function >
+void
+benchmarkFormat(const char* op, const char* expected, Function&& function)
+{
+	BlockDevice device;
+	modm::IOStream stream(device);
+
+	FakeIODevice::reset();
+	function(stream);
+	const std::size_t bytes = FakeIODevice::bytesWritten;
+	const std::size_t calls = FakeIODevice::writeCalls;
+	TEST_ASSERT_EQUALS(bytes, std::strlen(expected));
+	TEST_ASSERT_EQUALS(std::memcmp(FakeIODevice::sendBuffer, expected,
+			std::min(bytes, sizeof(FakeIODevice::sendBuffer))), 0);
+
+	CycleCounter counter;
+	for (uint32_t ii = 0; ii < rounds; ii++) {
+		function(stream);
+	}
+	const uint64_t time = counter.elapsed();
+
+	MODM_LOG_INFO << "format-benchmark op=" << op
+				  << " bytes=" << uint32_t(bytes)
+				  << " calls=" << uint32_t(calls)
+				  << " time=";
+	printFixed(time * 100 / rounds);
+	MODM_LOG_INFO << " unit=" << CycleCounter::unit << modm::endl;
+}
+
+}	// anonymous namespace
+#endif
+
+// ----------------------------------------------------------------------------
+void
+IoStreamBenchmarkTest::testString()
+{
+#ifdef MODM_OS_HOSTED
+	compare("string", "Lorem ipsum dolor sit amet, consectetur\n", [](modm::IOStream& stream)
+	{
+		stream << "Lorem ipsum dolor sit amet, consectetur" << modm::endl;
+	});
+#endif
+}
+
+void
+IoStreamBenchmarkTest::testIntegers()
+{
+#ifdef MODM_OS_HOSTED
+	compare("integers", "x=-123456 y=4711 z=42\n", [](modm::IOStream& stream)
+	{
+		stream << "x=" << int32_t(-123456) << " y=" << uint16_t(4711)
+			   << " z=" << uint8_t(42) << modm::endl;
+	});
+#endif
+}
+
+void
+IoStreamBenchmarkTest::testHexadecimal()
+{
+#ifdef MODM_OS_HOSTED
+	compare("hexadecimal", "id=DEADBEEF mask=10100101\n", [](modm::IOStream& stream)
+	{
+		stream << "id=" << modm::hex << uint32_t(0xdeadbeef) << modm::ascii
+			   << " mask=" << modm::bin << uint8_t(0xa5) << modm::ascii << modm::endl;
+	});
+#endif
+}
+
+void
+IoStreamBenchmarkTest::testPrintf()
+{
+#ifdef MODM_OS_HOSTED
+	compare("printf", "x=-123456 y=4711 z=2a\n", [](modm::IOStream& stream)
+	{
+		stream.printf("x=%ld y=%u z=%02x\n", -123456l, 4711u, 42u);
+	});
+#endif
+}
+
+void
+IoStreamBenchmarkTest::testFormat()
+{
+#ifdef MODM_OS_HOSTED
+	// the values are volatile, so that the compiler cannot format them in advance
+	static volatile int32_t x = -123456;
+	static volatile uint16_t y = 4711;
+	static volatile uint8_t z = 42;
+
+	const char* integers = "x=-123456 y=4711 z=2A\n";
+	benchmarkFormat("format", integers, [](modm::IOStream& stream)
+	{
+		modm::format<"x={} y={} z={:02X}\n">(stream, x, y, z);
+	});
+	benchmarkFormat("printf", integers, [](modm::IOStream& stream)
+	{
+		stream.printf("x=%ld y=%u z=%02X\n", long(x), unsigned(y), unsigned(z));
+	});
+	benchmarkFormat("stream", integers, [](modm::IOStream& stream)
+	{
+		stream << "x=" << int32_t(x) << " y=" << uint16_t(y) << " z="
+			   << modm::hex << uint8_t(z) << modm::ascii << modm::endl;
+	});
+
+	const char* aligned = "[ready   ] 0x0000BEEF\n";
+	static volatile uint32_t value = 0xbeef;
+	benchmarkFormat("format-aligned", aligned, [](modm::IOStream& stream)
+	{
+		modm::format<"[{:<8}] 0x{:08X}\n">(stream, "ready", value);
+	});
+	benchmarkFormat("printf-aligned", aligned, [](modm::IOStream& stream)
+	{
+		stream.printf("[%-8s] 0x%08lX\n", "ready", static_cast<unsigned long>(value));
+	});
+#endif
+}
@@ -0,0 +1,41 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include <unittest/testsuite.hpp>
+
+/**
+ * Compares the throughput of an IOStream writing every character on its own
+ * with one writing blocks of characters to the device, and the cost of
+ * `modm::format()`, `printf()` and `operator <<` for the same line.
+ *
+ * Every measurement prints one line in a fixed format. The assertions only
+ * check the output and the number of device calls, since the timing depends
+ * on the host.
+ *
+ * @ingroup modm_test_test_io
+ */
+class IoStreamBenchmarkTest : public unittest::TestSuite
+{
+public:
+	void
+	testString();
+
+	void
+	testIntegers();
+
+	void
+	testHexadecimal();
+
+	void
+	testPrintf();
+
+	// modm::format() compared to printf() and operator <<
+	void
+	testFormat();
+};
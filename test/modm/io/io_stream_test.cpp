@@ -19,6 +19,7 @@
 
 #include <modm/architecture/utils.hpp> // MODM_ARRAY_SIZE
 #include <modm-test/mock/iodevice.hpp>
+#include <modm-test/mock/io_device.hpp>
 #include <stdio.h>	// snprintf
 #include <string.h>	// memset
 #include <limits>
@@ -623,3 +624,63 @@ IoStreamTest::testPointer()
 	TEST_ASSERT_EQUALS_ARRAY(string, device.buffer, bytesWritten);
 	TEST_ASSERT_EQUALS(device.bytesWritten, bytesWritten);
 }
+
+void
+IoStreamTest::testStreamPointer()
+{
+#if MODM_SIZEOF_POINTER == 2
+	char string[] = "0x0123";
+	const void* p = (const void *) 0x0123;
+#elif MODM_SIZEOF_POINTER == 4
+	char string[] = "0x01234567";
+	const void* p = (const void *) 0x01234567;
+#else
+	char string[] = "0x0123456789ABCDEF";
+	const void* p = (const void *) 0x0123456789ABCDEF;
+#endif
+
+	(*stream) << p;
+
+	TEST_ASSERT_EQUALS_ARRAY(string, device.buffer, sizeof(string) - 1);
+	TEST_ASSERT_EQUALS(device.bytesWritten, sizeof(string) - 1);
+}
+
+// ----------------------------------------------------------------------------
+using FakeIODevice = modm_test::FakeIODevice;
+
+void
+IoStreamTest::testWrapperBlockWrite()
+{
+	modm::IODeviceWrapper<FakeIODevice, modm::IOBuffer::BlockIfFull> wrapper;
+	modm::IOStream blockStream(wrapper);
+	FakeIODevice::reset();
+
+	// every value is passed to the device in one call
+	blockStream << "abc" << int32_t(-2147483647) << modm::hex << uint32_t(0x12345678);
+
+	const uint8_t expected[] = "abc-214748364712345678";
+	TEST_ASSERT_EQUALS(FakeIODevice::bytesSend, sizeof(expected) - 1);
+	TEST_ASSERT_EQUALS_ARRAY(expected, FakeIODevice::sendBuffer, sizeof(expected) - 1);
+	TEST_ASSERT_EQUALS(FakeIODevice::writeCalls, 3U);
+}
+
+void
+IoStreamTest::testWrapperBlockRead()
+{
+	modm::IODeviceWrapper<FakeIODevice, modm::IOBuffer::BlockIfFull> wrapper;
+	modm::IOStream blockStream(wrapper);
+	FakeIODevice::reset();
+
+	blockStream << "hello";
+	FakeIODevice::moveSendToReceiveBuffer();
+
+	char string[4];
+	blockStream.get(string);
+	TEST_ASSERT_EQUALS_ARRAY("hel", string, 4);
+
+	blockStream.get(string);
+	TEST_ASSERT_EQUALS_ARRAY("lo", string, 3);
+
+	blockStream.get(string);
+	TEST_ASSERT_EQUALS(string[0], '\0');
+}
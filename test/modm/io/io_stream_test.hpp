@@ -169,6 +169,16 @@ public:
 	void
 	testPointer();
 
+	void
+	testStreamPointer();
+
+	// IODeviceWrapper
+	void
+	testWrapperBlockWrite();
+
+	void
+	testWrapperBlockRead();
+
 private:
 	modm::IOStream *stream;
 };
@@ -12,6 +12,7 @@
  */
 // ----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <cstring>
 #include "io_device.hpp"
 
@@ -20,10 +21,26 @@ modm_test::FakeIODevice::setBaudrate(uint32_t)
 {
 }
 
-void
+bool
 modm_test::FakeIODevice::write(uint8_t data)
 {
-	sendBuffer[bytesSend++] = data;
+	return write(&data, 1) == 1;
+}
+
+std::size_t
+modm_test::FakeIODevice::write(const uint8_t* data, std::size_t length)
+{
+	const std::size_t stored = std::min(length, sizeof(sendBuffer) - bytesSend);
+	std::memcpy(sendBuffer + bytesSend, data, stored);
+	bytesSend += stored;
+	bytesWritten += length;
+	writeCalls++;
+	return length;
+}
+
+void
+modm_test::FakeIODevice::flushWriteBuffer()
+{
 }
 
 bool
@@ -38,6 +55,13 @@ modm_test::FakeIODevice::read(uint8_t& byte)
 	}
 }
 
+std::size_t
+modm_test::FakeIODevice::read(uint8_t* data, std::size_t length)
+{
+	std::size_t count = 0;
+	while (count < length and read(data[count])) count++;
+	return count;
+}
 
 void
 modm_test::FakeIODevice::reset()
@@ -45,6 +69,8 @@ modm_test::FakeIODevice::reset()
 	bytesReceived = 0;
 	receivePosition = 0;
 	bytesSend = 0;
+	bytesWritten = 0;
+	writeCalls = 0;
 }
 
 void
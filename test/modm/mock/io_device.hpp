@@ -15,6 +15,7 @@
 #define FAKE_IO_DEVICE_HPP
 
 #include <stdint.h>
+#include <cstddef>
 
 namespace modm_test
 {
@@ -26,12 +27,22 @@ public:
 	static void
 	setBaudrate(uint32_t);
 
-	static void
+	/// Stores the byte until the send buffer is full, then only counts it.
+	static bool
 	write(uint8_t data);
 
+	static std::size_t
+	write(const uint8_t* data, std::size_t length);
+
+	static void
+	flushWriteBuffer();
+
 	static bool
 	read(uint8_t& byte);
 
+	static std::size_t
+	read(uint8_t* data, std::size_t length);
+
 	static void
 	reset();
 
@@ -41,6 +52,10 @@ public:
 
 	static inline uint8_t sendBuffer[40];
 	static inline uint8_t bytesSend{0};
+	/// Number of bytes written since the last reset, including the ones not stored
+	static inline std::size_t bytesWritten{0};
+	/// Number of write calls since the last reset
+	static inline std::size_t writeCalls{0};
 
 	static inline uint8_t receiveBuffer[40];
 	static inline uint8_t receivePosition{0};
@@ -0,0 +1,130 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "fiber_await_test.hpp"
+
+#include <modm/processing/fiber.hpp>
+#include <modm/processing/resumable.hpp>
+
+namespace
+{
+
+modm::fiber::Stack<1024> stack1, stack2;
+
+/// Resumable driver that waits for a number of polls before it returns.
+class Driver : public modm::NestedResumable<2>
+{
+public:
+	modm::ResumableResult<uint8_t>
+	read(uint8_t polls)
+	{
+		RF_BEGIN();
+		remaining = polls;
+		RF_WAIT_WHILE(remaining-- > 0);
+		calls++;
+		RF_END_RETURN(uint8_t(polls + 1));
+	}
+
+	modm::ResumableResult<uint16_t>
+	readTwice(uint8_t polls)
+	{
+		RF_BEGIN();
+		first = RF_CALL(read(polls));
+		second = RF_CALL(read(polls));
+		RF_END_RETURN(uint16_t(first + second));
+	}
+
+	modm::ResumableResult<void>
+	reset()
+	{
+		RF_BEGIN();
+		calls = 0;
+		RF_END();
+	}
+
+	uint8_t calls{0};
+
+private:
+	uint8_t remaining;
+	uint8_t first;
+	uint8_t second;
+};
+
+Driver driver;
+uint32_t other_runs = 0;
+
+void
+other()
+{
+	while (other_runs < 100)
+	{
+		other_runs++;
+		modm::fiber::yield();
+	}
+}
+
+}  // namespace
+
+void
+FiberAwaitTest::testAwaitYieldsBetweenSteps()
+{
+	other_runs = 0;
+	driver.calls = 0;
+	uint8_t result{0};
+	uint32_t runs_before{0};
+	modm::Fiber fiber1(stack1, [&]()
+	{
+		runs_before = other_runs;
+		result = modm::fiber::await([]{ return driver.read(5); });
+		// the other fiber ran once for every poll of the driver
+		TEST_ASSERT_EQUALS(other_runs - runs_before, 5u);
+	});
+	modm::Fiber fiber2(stack2, other);
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(result, 6);
+	TEST_ASSERT_EQUALS(driver.calls, 1);
+}
+
+void
+FiberAwaitTest::testAwaitSynchronous()
+{
+	other_runs = 0;
+	driver.calls = 1;
+	modm::Fiber fiber1(stack1, []()
+	{
+		TEST_ASSERT_EQUALS(modm::fiber::await([]{ return driver.read(0); }), 1);
+		// void resumables return their state like RF_CALL_BLOCKING()
+		TEST_ASSERT_EQUALS(modm::fiber::await([]{ return driver.reset(); }), modm::rf::Stop);
+		// completed without yielding to the other fiber
+		TEST_ASSERT_EQUALS(other_runs, 0u);
+	});
+	modm::Fiber fiber2(stack2, other);
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(driver.calls, 0);
+}
+
+void
+FiberAwaitTest::testAwaitNested()
+{
+	other_runs = 0;
+	driver.calls = 0;
+	uint16_t result{0};
+	modm::Fiber fiber1(stack1, [&]()
+	{
+		result = modm::fiber::await([]{ return driver.readTwice(3); });
+	});
+	modm::Fiber fiber2(stack2, other);
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(result, 8u);
+	TEST_ASSERT_EQUALS(driver.calls, 2);
+	TEST_ASSERT_EQUALS(other_runs, 100u);
+}
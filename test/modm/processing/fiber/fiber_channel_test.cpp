@@ -0,0 +1,187 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "fiber_channel_test.hpp"
+
+#include <array>
+#include <modm/processing/fiber.hpp>
+
+namespace
+{
+
+enum State
+{
+	INVALID,
+	A_START,
+	A_END,
+	B_START,
+	B_YIELD1,
+	B_YIELD2,
+	B_END,
+	C_START,
+	C_END,
+	D_START,
+	D_END,
+};
+
+std::array<State, 10> states = {};
+size_t states_pos = 0;
+
+#define ADD_STATE(state) states[states_pos++] = state;
+
+modm::fiber::Stack<1024> stack1, stack2, stack3, stack4;
+
+}  // namespace
+
+void
+FiberChannelTest::testNonBlocking()
+{
+	modm::fiber::Channel<uint8_t, 3> channel;
+	TEST_ASSERT_EQUALS(channel.capacity(), 3u);
+	TEST_ASSERT_TRUE(channel.empty());
+	TEST_ASSERT_FALSE(channel.full());
+
+	uint8_t value{0};
+	TEST_ASSERT_FALSE(channel.tryReceive(value));
+
+	TEST_ASSERT_TRUE(channel.trySend(1));
+	TEST_ASSERT_TRUE(channel.trySend(2));
+	TEST_ASSERT_TRUE(channel.trySend(3));
+	TEST_ASSERT_TRUE(channel.full());
+	TEST_ASSERT_FALSE(channel.trySend(4));
+	TEST_ASSERT_EQUALS(channel.size(), 3u);
+
+	TEST_ASSERT_TRUE(channel.tryReceive(value));
+	TEST_ASSERT_EQUALS(value, 1);
+	// wrap around the ring buffer
+	TEST_ASSERT_TRUE(channel.trySend(5));
+	TEST_ASSERT_TRUE(channel.tryReceive(value));
+	TEST_ASSERT_EQUALS(value, 2);
+	TEST_ASSERT_TRUE(channel.tryReceive(value));
+	TEST_ASSERT_EQUALS(value, 3);
+	TEST_ASSERT_TRUE(channel.tryReceive(value));
+	TEST_ASSERT_EQUALS(value, 5);
+	TEST_ASSERT_TRUE(channel.empty());
+}
+
+namespace
+{
+
+modm::fiber::Channel<uint16_t, 2> channel;
+std::array<uint16_t, 20> received = {};
+size_t received_pos = 0;
+
+}  // namespace
+
+void
+FiberChannelTest::testProducerConsumer()
+{
+	received_pos = 0;
+	modm::Fiber producer(stack1, []()
+	{
+		for (uint16_t ii = 0; ii < received.size(); ii++) channel.send(ii * 3);
+	});
+	modm::Fiber consumer(stack2, []()
+	{
+		while (received_pos < received.size())
+			received[received_pos++] = channel.receive();
+	});
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(received_pos, received.size());
+	for (uint16_t ii = 0; ii < received.size(); ii++) {
+		TEST_ASSERT_EQUALS(received[ii], ii * 3);
+	}
+	TEST_ASSERT_TRUE(channel.empty());
+}
+
+void
+FiberChannelTest::testWaitersLeaveReadyQueue()
+{
+	states_pos = 0;
+	modm::Fiber fiberA(stack1, []()
+	{
+		ADD_STATE(A_START);
+		const uint16_t value = channel.receive();
+		TEST_ASSERT_EQUALS(value, 42u);
+		ADD_STATE(A_END);
+	});
+	modm::Fiber fiberB(stack2, []()
+	{
+		ADD_STATE(B_START);
+		// fiber A is not in the ready queue anymore, so it does not get resumed
+		modm::fiber::yield();
+		ADD_STATE(B_YIELD1);
+		modm::fiber::yield();
+		ADD_STATE(B_YIELD2);
+		channel.send(42);
+		ADD_STATE(B_END);
+	});
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(states_pos, 6u);
+	TEST_ASSERT_EQUALS(states[0], A_START);
+	TEST_ASSERT_EQUALS(states[1], B_START);
+	TEST_ASSERT_EQUALS(states[2], B_YIELD1);
+	TEST_ASSERT_EQUALS(states[3], B_YIELD2);
+	TEST_ASSERT_EQUALS(states[4], B_END);
+	TEST_ASSERT_EQUALS(states[5], A_END);
+}
+
+namespace
+{
+
+modm::fiber::Waitable waitable;
+
+}  // namespace
+
+void
+FiberChannelTest::testWaitableSignal()
+{
+	states_pos = 0;
+	modm::Fiber fiberA(stack1, []()
+	{
+		ADD_STATE(A_START);
+		waitable.wait();
+		ADD_STATE(A_END);
+	});
+	modm::Fiber fiberC(stack2, []()
+	{
+		ADD_STATE(C_START);
+		waitable.wait();
+		ADD_STATE(C_END);
+	});
+	modm::Fiber fiberD(stack3, []()
+	{
+		ADD_STATE(D_START);
+		waitable.wait();
+		ADD_STATE(D_END);
+	});
+	modm::Fiber fiberB(stack4, []()
+	{
+		ADD_STATE(B_START);
+		TEST_ASSERT_TRUE(waitable.hasWaiters());
+		// only wakes up the longest waiting fiber A
+		TEST_ASSERT_TRUE(waitable.signal());
+		modm::fiber::yield();
+		waitable.signalAll();
+		TEST_ASSERT_FALSE(waitable.hasWaiters());
+		TEST_ASSERT_FALSE(waitable.signal());
+	});
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(states_pos, 7u);
+	TEST_ASSERT_EQUALS(states[0], A_START);
+	TEST_ASSERT_EQUALS(states[1], C_START);
+	TEST_ASSERT_EQUALS(states[2], D_START);
+	TEST_ASSERT_EQUALS(states[3], B_START);
+	TEST_ASSERT_EQUALS(states[4], A_END);
+	TEST_ASSERT_EQUALS(states[5], C_END);
+	TEST_ASSERT_EQUALS(states[6], D_END);
+}
@@ -0,0 +1,150 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "fiber_pool_test.hpp"
+
+#include <array>
+#include <modm/processing/fiber.hpp>
+
+namespace
+{
+
+std::array<uint8_t, 20> states = {};
+size_t states_pos = 0;
+
+#define ADD_STATE(state) states[states_pos++] = state;
+
+modm::fiber::Stack<1024> stack1;
+modm::fiber::Pool<1024, 2> pool;
+
+struct Counted
+{
+	Counted(uint8_t& destroyed) : destroyed(&destroyed) {}
+	Counted(Counted&& other) : destroyed(other.destroyed) { other.destroyed = nullptr; }
+	~Counted() { if (destroyed) (*destroyed)++; }
+	uint8_t* destroyed;
+};
+
+}  // namespace
+
+void
+FiberPoolTest::testSpawnJoin()
+{
+	states_pos = 0;
+	modm::Fiber fiber1(stack1, []()
+	{
+		ADD_STATE(1);
+		auto handle1 = pool.spawn([]
+		{
+			ADD_STATE(3);
+			modm::fiber::yield();
+			ADD_STATE(5);
+		});
+		auto handle2 = pool.spawn([] { ADD_STATE(4); });
+		TEST_ASSERT_TRUE(handle1);
+		TEST_ASSERT_TRUE(handle2);
+		TEST_ASSERT_EQUALS(pool.available(), 0u);
+		TEST_ASSERT_TRUE(handle1.joinable());
+		ADD_STATE(2);
+		handle1.join();
+		ADD_STATE(6);
+		TEST_ASSERT_FALSE(handle1.joinable());
+		TEST_ASSERT_FALSE(handle2.joinable());
+		// joining a returned fiber does not suspend
+		handle2.join();
+		TEST_ASSERT_EQUALS(pool.available(), 2u);
+		ADD_STATE(7);
+	});
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(states_pos, 7u);
+	for (size_t ii = 0; ii < states_pos; ii++)
+		TEST_ASSERT_EQUALS(states[ii], ii + 1);
+}
+
+void
+FiberPoolTest::testJoinAfterOtherReturned()
+{
+	states_pos = 0;
+	modm::Fiber fiber1(stack1, []()
+	{
+		auto handle1 = pool.spawn([]
+		{
+			ADD_STATE(2);
+			for (int ii = 0; ii < 3; ii++) modm::fiber::yield();
+			ADD_STATE(4);
+		});
+		auto handle2 = pool.spawn([] { ADD_STATE(3); });
+		ADD_STATE(1);
+		// the second fiber returns first and wakes up all joining fibers
+		handle1.join();
+		ADD_STATE(5);
+		TEST_ASSERT_FALSE(handle1.joinable());
+		TEST_ASSERT_FALSE(handle2.joinable());
+		TEST_ASSERT_EQUALS(pool.available(), 2u);
+	});
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(states_pos, 5u);
+	for (size_t ii = 0; ii < states_pos; ii++)
+		TEST_ASSERT_EQUALS(states[ii], ii + 1);
+}
+
+void
+FiberPoolTest::testPoolExhausted()
+{
+	states_pos = 0;
+	modm::Fiber fiber1(stack1, []()
+	{
+		auto handle1 = pool.spawn([] { ADD_STATE(1); });
+		auto handle2 = pool.spawn([] { ADD_STATE(2); });
+		auto handle3 = pool.spawn([] { ADD_STATE(3); });
+		TEST_ASSERT_TRUE(handle1);
+		TEST_ASSERT_TRUE(handle2);
+		TEST_ASSERT_FALSE(handle3);
+		TEST_ASSERT_FALSE(handle3.joinable());
+		handle3.join();
+
+		handle1.join();
+		handle2.join();
+		// the stacks are reused, the old handles do not refer to the new fibers
+		auto handle4 = pool.spawn([] { ADD_STATE(4); });
+		TEST_ASSERT_TRUE(handle4);
+		TEST_ASSERT_TRUE(handle4.joinable());
+		TEST_ASSERT_FALSE(handle1.joinable());
+		TEST_ASSERT_FALSE(handle2.joinable());
+		handle4.join();
+	});
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(states_pos, 3u);
+	TEST_ASSERT_EQUALS(states[0], 1);
+	TEST_ASSERT_EQUALS(states[1], 2);
+	TEST_ASSERT_EQUALS(states[2], 4);
+	TEST_ASSERT_EQUALS(pool.available(), 2u);
+}
+
+void
+FiberPoolTest::testClosureDestroyed()
+{
+	uint8_t destroyed{0};
+	modm::Fiber fiber1(stack1, [&destroyed]()
+	{
+		auto handle = pool.spawn([counted = Counted{destroyed}]
+		{
+			modm::fiber::yield();
+		});
+		TEST_ASSERT_EQUALS(destroyed, 0);
+		handle.join();
+		TEST_ASSERT_EQUALS(destroyed, 1);
+	});
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(destroyed, 1);
+}
@@ -0,0 +1,162 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "fiber_priority_test.hpp"
+
+#include <array>
+#include <modm/processing/fiber.hpp>
+
+namespace
+{
+
+enum State
+{
+	INVALID,
+	LOW_START,
+	LOW_END,
+	MID_START,
+	MID_END,
+	HIGH_START,
+	HIGH_YIELD,
+	HIGH_END,
+};
+
+std::array<State, 10> states = {};
+size_t states_pos = 0;
+
+#define ADD_STATE(state) states[states_pos++] = state;
+
+modm::fiber::Stack<1024> stack1, stack2, stack3;
+
+}  // namespace
+
+void
+FiberPriorityTest::testPriorityOrder()
+{
+	states_pos = 0;
+	modm::Fiber low(stack1, []()
+	{
+		ADD_STATE(LOW_START);
+		modm::fiber::yield();
+		ADD_STATE(LOW_END);
+	}, 0);
+	modm::Fiber high(stack2, []()
+	{
+		ADD_STATE(HIGH_START);
+		// no other fiber with the same priority, so this returns immediately
+		modm::fiber::yield();
+		ADD_STATE(HIGH_YIELD);
+		modm::fiber::yield();
+		ADD_STATE(HIGH_END);
+	}, 2);
+	modm::Fiber mid(stack3, []()
+	{
+		ADD_STATE(MID_START);
+		modm::fiber::yield();
+		ADD_STATE(MID_END);
+	}, 1);
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(states_pos, 7u);
+	TEST_ASSERT_EQUALS(states[0], HIGH_START);
+	TEST_ASSERT_EQUALS(states[1], HIGH_YIELD);
+	TEST_ASSERT_EQUALS(states[2], HIGH_END);
+	TEST_ASSERT_EQUALS(states[3], MID_START);
+	TEST_ASSERT_EQUALS(states[4], MID_END);
+	TEST_ASSERT_EQUALS(states[5], LOW_START);
+	TEST_ASSERT_EQUALS(states[6], LOW_END);
+}
+
+void
+FiberPriorityTest::testRoundRobinWithinPriority()
+{
+	states_pos = 0;
+	modm::Fiber low(stack1, []()
+	{
+		ADD_STATE(LOW_START);
+		ADD_STATE(LOW_END);
+	}, 0);
+	modm::Fiber high1(stack2, []()
+	{
+		ADD_STATE(HIGH_START);
+		modm::fiber::yield();
+		ADD_STATE(HIGH_END);
+	}, 1);
+	modm::Fiber high2(stack3, []()
+	{
+		ADD_STATE(MID_START);
+		modm::fiber::yield();
+		ADD_STATE(MID_END);
+	}, 1);
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(states_pos, 6u);
+	TEST_ASSERT_EQUALS(states[0], HIGH_START);
+	TEST_ASSERT_EQUALS(states[1], MID_START);
+	TEST_ASSERT_EQUALS(states[2], HIGH_END);
+	TEST_ASSERT_EQUALS(states[3], MID_END);
+	TEST_ASSERT_EQUALS(states[4], LOW_START);
+	TEST_ASSERT_EQUALS(states[5], LOW_END);
+}
+
+namespace
+{
+
+constexpr size_t low_fibers = 50;
+constexpr uint32_t wakeups = 20;
+
+modm::fiber::Stack<1024> stack_low[low_fibers];
+modm::fiber::Stack<1024> stack_high;
+modm::fiber::Waitable event;
+bool running;
+uint32_t low_resumes;
+uint32_t signaled_at;
+uint32_t worst_latency;
+
+}  // namespace
+
+void
+FiberPriorityTest::testWakeupLatency()
+{
+	running = true;
+	low_resumes = 0;
+	worst_latency = 0;
+	// Fibers must not be copied, so construct them in place
+	alignas(modm::Fiber) uint8_t storage[low_fibers][sizeof(modm::Fiber)];
+	for (size_t ii = 0; ii < low_fibers; ii++)
+	{
+		new (storage[ii]) modm::Fiber(stack_low[ii], []()
+		{
+			while (running)
+			{
+				// every 100 resumes one of the low priority fibers wakes up
+				// the high priority fiber
+				if (++low_resumes % 100 == 0 and event.signal())
+					signaled_at = low_resumes;
+				modm::fiber::yield();
+			}
+		}, 0);
+	}
+	modm::Fiber high(stack_high, []()
+	{
+		for (uint32_t ii = 0; ii < wakeups; ii++)
+		{
+			event.wait();
+			// number of low priority fibers resumed after the wakeup
+			worst_latency = std::max(worst_latency, low_resumes - signaled_at);
+		}
+		running = false;
+	}, 1);
+	modm::fiber::Scheduler::run();
+
+	// The high priority fiber runs as soon as the signaling fiber yields,
+	// instead of waiting until all other ready fibers had their turn.
+	TEST_ASSERT_EQUALS(worst_latency, 0u);
+	TEST_ASSERT_FALSE(event.hasWaiters());
+}
@@ -0,0 +1,130 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "fiber_reactor_test.hpp"
+
+#include <modm/processing/fiber.hpp>
+#include <fcntl.h>
+#include <sys/timerfd.h>
+
+namespace
+{
+
+// Calling into the C library on hosted requires larger stacks
+modm::fiber::Stack<8192> stack1, stack2, stack3;
+
+int fds[2];
+char received[4];
+size_t received_pos = 0;
+uint32_t yields = 0;
+
+void
+reader()
+{
+	char data;
+	while (received_pos < 2)
+	{
+		TEST_ASSERT_EQUALS(modm::fiber::read(fds[0], &data, 1), 1);
+		received[received_pos++] = data;
+	}
+}
+
+}  // namespace
+
+void
+FiberReactorTest::testReadSuspendsUntilWritten()
+{
+	TEST_ASSERT_EQUALS(pipe2(fds, O_NONBLOCK), 0);
+	received_pos = 0;
+	yields = 0;
+
+	modm::Fiber fiber1(stack1, reader);
+	modm::Fiber fiber2(stack2, []()
+	{
+		// the reader waits in the reactor and is not resumed by yielding
+		for (; yields < 5; yields++) modm::fiber::yield();
+		TEST_ASSERT_EQUALS(received_pos, 0u);
+		TEST_ASSERT_EQUALS(modm::fiber::write(fds[1], "ab", 2), 2);
+		modm::fiber::yield();
+		TEST_ASSERT_EQUALS(received_pos, 2u);
+	});
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(received_pos, 2u);
+	TEST_ASSERT_EQUALS(received[0], 'a');
+	TEST_ASSERT_EQUALS(received[1], 'b');
+	::close(fds[0]);
+	::close(fds[1]);
+}
+
+void
+FiberReactorTest::testOnlyFiberBlocksInKernel()
+{
+	const int timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+	TEST_ASSERT_TRUE(timer >= 0);
+	const itimerspec expiry{{0, 0}, {0, 1'000'000}};
+	TEST_ASSERT_EQUALS(timerfd_settime(timer, 0, &expiry, nullptr), 0);
+
+	uint64_t expirations{0};
+	// the scheduler has no other fiber to run and blocks in epoll_wait()
+	modm::Fiber fiber1(stack1, [&]()
+	{
+		TEST_ASSERT_EQUALS(modm::fiber::read(timer, &expirations, sizeof(expirations)),
+						   ssize_t(sizeof(expirations)));
+	});
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(expirations, 1u);
+	::close(timer);
+}
+
+void
+FiberReactorTest::testSecondWaiterFallsBack()
+{
+	TEST_ASSERT_EQUALS(pipe2(fds, O_NONBLOCK), 0);
+	received_pos = 0;
+
+	// Both fibers wait for the same file descriptor, but only the first one
+	// can be registered with epoll, the second one polls in a yield loop.
+	modm::Fiber fiber1(stack1, []()
+	{
+		TEST_ASSERT_TRUE(modm::fiber::poll(fds[0], EPOLLIN) & EPOLLIN);
+		received[received_pos++] = '1';
+	});
+	modm::Fiber fiber2(stack2, []()
+	{
+		TEST_ASSERT_TRUE(modm::fiber::poll(fds[0], EPOLLIN) & EPOLLIN);
+		received[received_pos++] = '2';
+	});
+	modm::Fiber fiber3(stack3, []()
+	{
+		modm::fiber::yield();
+		TEST_ASSERT_EQUALS(received_pos, 0u);
+		TEST_ASSERT_EQUALS(modm::fiber::write(fds[1], "x", 1), 1);
+	});
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(received_pos, 2u);
+	::close(fds[0]);
+	::close(fds[1]);
+}
+
+void
+FiberReactorTest::testPollOutsideFiber()
+{
+	TEST_ASSERT_EQUALS(pipe2(fds, O_NONBLOCK), 0);
+	TEST_ASSERT_EQUALS(modm::fiber::poll(fds[1], EPOLLOUT), uint32_t(EPOLLOUT));
+	TEST_ASSERT_EQUALS(modm::fiber::write(fds[1], "z", 1), 1);
+	TEST_ASSERT_EQUALS(modm::fiber::poll(fds[0], EPOLLIN), uint32_t(EPOLLIN));
+	char data;
+	TEST_ASSERT_EQUALS(modm::fiber::read(fds[0], &data, 1), 1);
+	TEST_ASSERT_EQUALS(data, 'z');
+	::close(fds[0]);
+	::close(fds[1]);
+}
@@ -0,0 +1,162 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "fiber_sleep_test.hpp"
+
+#include <array>
+#include <modm/processing/fiber.hpp>
+#include <modm-test/mock/clock.hpp>
+
+using namespace std::chrono_literals;
+using test_clock = modm_test::chrono::micro_clock;
+using test_milli_clock = modm_test::chrono::milli_clock;
+
+namespace
+{
+
+modm::fiber::Stack<1024> stack1, stack2, stack3, stack4;
+
+std::array<uint32_t, 3> wakeups = {};
+std::array<uint8_t, 3> order = {};
+size_t order_pos = 0;
+uint32_t resumes = 0;
+
+void
+ticker(uint32_t ticks, uint32_t increment = 1)
+{
+	for (uint32_t ii = 0; ii < ticks; ii++)
+	{
+		test_clock::increment(increment);
+		modm::fiber::yield();
+	}
+}
+
+void
+sleeper(uint8_t index, std::chrono::microseconds interval)
+{
+	modm::fiber::sleep_for(interval);
+	wakeups[index] = modm::PreciseClock::now().time_since_epoch().count();
+	order[order_pos++] = index;
+}
+
+}  // namespace
+
+void
+FiberSleepTest::setUp()
+{
+	test_clock::setTime(0);
+	test_milli_clock::setTime(0);
+	order_pos = 0;
+	resumes = 0;
+}
+
+void
+FiberSleepTest::testSleepOrder()
+{
+	modm::Fiber fiber1(stack1, []() { sleeper(0, 30us); });
+	modm::Fiber fiber2(stack2, []() { sleeper(1, 10us); });
+	modm::Fiber fiber3(stack3, []() { sleeper(2, 20us); });
+	modm::Fiber fiber4(stack4, []() { ticker(40); });
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(order_pos, 3u);
+	TEST_ASSERT_EQUALS(order[0], 1u);
+	TEST_ASSERT_EQUALS(order[1], 2u);
+	TEST_ASSERT_EQUALS(order[2], 0u);
+	TEST_ASSERT_EQUALS(wakeups[0], 30u);
+	TEST_ASSERT_EQUALS(wakeups[1], 10u);
+	TEST_ASSERT_EQUALS(wakeups[2], 20u);
+}
+
+void
+FiberSleepTest::testSleepingFiberIsNotResumed()
+{
+	modm::Fiber fiber1(stack1, []()
+	{
+		resumes++;
+		modm::fiber::sleep_for(100us);
+		resumes++;
+	});
+	modm::Fiber fiber2(stack2, []()
+	{
+		ticker(99);
+		// only the ticker was resumed, the sleeping fiber was not
+		TEST_ASSERT_EQUALS(resumes, 1u);
+		ticker(1);
+		modm::fiber::yield();
+		TEST_ASSERT_EQUALS(resumes, 2u);
+	});
+	modm::fiber::Scheduler::run();
+	TEST_ASSERT_EQUALS(resumes, 2u);
+}
+
+void
+FiberSleepTest::testSleepOverflow()
+{
+	test_clock::setTime(0xffff'fff0);
+	modm::Fiber fiber1(stack1, []() { sleeper(0, 32us); });
+	modm::Fiber fiber2(stack2, []() { sleeper(1, 8us); });
+	modm::Fiber fiber3(stack3, []() { ticker(40); });
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(order_pos, 2u);
+	TEST_ASSERT_EQUALS(order[0], 1u);
+	TEST_ASSERT_EQUALS(order[1], 0u);
+	TEST_ASSERT_EQUALS(wakeups[0], 16u);
+	TEST_ASSERT_EQUALS(wakeups[1], 0xffff'fff8);
+}
+
+void
+FiberSleepTest::testSleepForMilliseconds()
+{
+	modm::Fiber fiber1(stack1, []()
+	{
+		modm::fiber::sleep_for(2ms);
+		wakeups[0] = modm::PreciseClock::now().time_since_epoch().count();
+		// deadline relative to the millisecond clock
+		modm::fiber::sleep_until(modm::Clock::time_point{5ms});
+		wakeups[1] = modm::PreciseClock::now().time_since_epoch().count();
+		// deadline in the past returns immediately
+		modm::fiber::sleep_until(modm::Clock::time_point{0ms});
+		wakeups[2] = modm::PreciseClock::now().time_since_epoch().count();
+	});
+	modm::Fiber fiber2(stack2, []() { ticker(100, 100); });
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(wakeups[0], 2000u);
+	TEST_ASSERT_EQUALS(wakeups[1], 7000u);
+	TEST_ASSERT_EQUALS(wakeups[2], 7000u);
+}
+
+void
+FiberSleepTest::testNextDeadline()
+{
+	TEST_ASSERT_FALSE(modm::fiber::Scheduler::nextDeadline());
+	modm::Fiber fiber1(stack1, []() { sleeper(0, 30us); });
+	modm::Fiber fiber2(stack2, []() { sleeper(1, 10us); });
+	modm::Fiber fiber3(stack3, []()
+	{
+		// both sleepers went to sleep at time zero
+		auto deadline = modm::fiber::Scheduler::nextDeadline();
+		TEST_ASSERT_TRUE(deadline);
+		TEST_ASSERT_EQUALS(deadline->time_since_epoch().count(), 10u);
+		ticker(10);
+		modm::fiber::yield();
+		deadline = modm::fiber::Scheduler::nextDeadline();
+		TEST_ASSERT_TRUE(deadline);
+		TEST_ASSERT_EQUALS(deadline->time_since_epoch().count(), 30u);
+		ticker(20);
+		modm::fiber::yield();
+		TEST_ASSERT_FALSE(modm::fiber::Scheduler::nextDeadline());
+	});
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(order_pos, 2u);
+	TEST_ASSERT_FALSE(modm::fiber::Scheduler::nextDeadline());
+}
@@ -0,0 +1,291 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "fiber_synchronization_test.hpp"
+
+#include <array>
+#include <mutex>
+#include <modm/processing/fiber.hpp>
+
+namespace
+{
+
+std::array<uint8_t, 20> states = {};
+size_t states_pos = 0;
+
+#define ADD_STATE(state) states[states_pos++] = state;
+
+modm::fiber::Stack<1024> stack1, stack2, stack3;
+
+}  // namespace
+
+void
+FiberSynchronizationTest::testMutex()
+{
+	modm::fiber::Mutex mutex;
+	// works outside of fibers too
+	TEST_ASSERT_TRUE(mutex.try_lock());
+	TEST_ASSERT_FALSE(mutex.try_lock());
+	mutex.unlock();
+	{
+		std::lock_guard guard{mutex};
+		TEST_ASSERT_FALSE(mutex.try_lock());
+	}
+	TEST_ASSERT_TRUE(mutex.try_lock());
+	mutex.unlock();
+}
+
+namespace
+{
+
+modm::fiber::Mutex mutex;
+
+}  // namespace
+
+void
+FiberSynchronizationTest::testMutexHandOff()
+{
+	states_pos = 0;
+	modm::Fiber fiberA(stack1, []()
+	{
+		mutex.lock();
+		ADD_STATE(1);
+		modm::fiber::yield();
+		modm::fiber::yield();
+		ADD_STATE(2);
+		mutex.unlock();
+		// the mutex was handed over to B, so A cannot take it back
+		TEST_ASSERT_FALSE(mutex.try_lock());
+		mutex.lock();
+		ADD_STATE(7);
+		mutex.unlock();
+	});
+	modm::Fiber fiberB(stack2, []()
+	{
+		ADD_STATE(3);
+		mutex.lock();
+		ADD_STATE(4);
+		modm::fiber::yield();
+		mutex.unlock();
+	});
+	modm::Fiber fiberC(stack3, []()
+	{
+		ADD_STATE(5);
+		mutex.lock();
+		ADD_STATE(6);
+		mutex.unlock();
+	});
+	modm::fiber::Scheduler::run();
+
+	// waiters acquire the mutex in FIFO order
+	TEST_ASSERT_EQUALS(states_pos, 7u);
+	TEST_ASSERT_EQUALS(states[0], 1);
+	TEST_ASSERT_EQUALS(states[1], 3);
+	TEST_ASSERT_EQUALS(states[2], 5);
+	TEST_ASSERT_EQUALS(states[3], 2);
+	TEST_ASSERT_EQUALS(states[4], 4);
+	TEST_ASSERT_EQUALS(states[5], 6);
+	TEST_ASSERT_EQUALS(states[6], 7);
+	TEST_ASSERT_TRUE(mutex.try_lock());
+	mutex.unlock();
+}
+
+namespace
+{
+
+modm::fiber::Semaphore semaphore{2};
+
+}  // namespace
+
+void
+FiberSynchronizationTest::testSemaphore()
+{
+	states_pos = 0;
+	TEST_ASSERT_EQUALS(semaphore.available(), 2u);
+	modm::Fiber fiberA(stack1, []()
+	{
+		for (uint8_t ii = 0; ii < 4; ii++) {
+			semaphore.acquire();
+			ADD_STATE(ii);
+		}
+		ADD_STATE(10);
+	});
+	modm::Fiber fiberB(stack2, []()
+	{
+		ADD_STATE(20);
+		TEST_ASSERT_FALSE(semaphore.try_acquire());
+		// A is waiting, so the count is handed over directly
+		semaphore.release(3);
+		TEST_ASSERT_EQUALS(semaphore.available(), 2u);
+		ADD_STATE(21);
+	});
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(states_pos, 7u);
+	TEST_ASSERT_EQUALS(states[0], 0);
+	TEST_ASSERT_EQUALS(states[1], 1);
+	TEST_ASSERT_EQUALS(states[2], 20);
+	TEST_ASSERT_EQUALS(states[3], 21);
+	TEST_ASSERT_EQUALS(states[4], 2);
+	TEST_ASSERT_EQUALS(states[5], 3);
+	TEST_ASSERT_EQUALS(states[6], 10);
+	// fiber A took one more count without waiting
+	TEST_ASSERT_EQUALS(semaphore.available(), 1u);
+	semaphore.release();
+}
+
+namespace
+{
+
+modm::fiber::ConditionVariable condition;
+uint8_t value{0};
+
+}  // namespace
+
+void
+FiberSynchronizationTest::testConditionVariable()
+{
+	states_pos = 0;
+	value = 0;
+	modm::Fiber fiberA(stack1, []()
+	{
+		std::lock_guard guard{mutex};
+		ADD_STATE(1);
+		condition.wait(mutex, []() { return value == 1; });
+		ADD_STATE(2);
+	});
+	modm::Fiber fiberB(stack2, []()
+	{
+		std::lock_guard guard{mutex};
+		ADD_STATE(3);
+		condition.wait(mutex, []() { return value == 2; });
+		ADD_STATE(4);
+	});
+	modm::Fiber fiberC(stack3, []()
+	{
+		ADD_STATE(5);
+		{
+			std::lock_guard guard{mutex};
+			value = 2;
+		}
+		condition.notify_all();
+		// A checks its predicate and waits again, B returns
+		modm::fiber::yield();
+		modm::fiber::yield();
+		ADD_STATE(6);
+		{
+			std::lock_guard guard{mutex};
+			value = 1;
+		}
+		condition.notify_one();
+	});
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_EQUALS(states_pos, 6u);
+	TEST_ASSERT_EQUALS(states[0], 1);
+	TEST_ASSERT_EQUALS(states[1], 3);
+	TEST_ASSERT_EQUALS(states[2], 5);
+	TEST_ASSERT_EQUALS(states[3], 4);
+	TEST_ASSERT_EQUALS(states[4], 6);
+	TEST_ASSERT_EQUALS(states[5], 2);
+	TEST_ASSERT_FALSE(condition.hasWaiters());
+}
+
+namespace
+{
+
+modm::fiber::Latch latch{3};
+
+}  // namespace
+
+void
+FiberSynchronizationTest::testLatch()
+{
+	states_pos = 0;
+	TEST_ASSERT_FALSE(latch.try_wait());
+	modm::Fiber fiberA(stack1, []()
+	{
+		ADD_STATE(1);
+		latch.arrive_and_wait();
+		ADD_STATE(2);
+	});
+	modm::Fiber fiberB(stack2, []()
+	{
+		ADD_STATE(3);
+		latch.wait();
+		ADD_STATE(4);
+	});
+	modm::Fiber fiberC(stack3, []()
+	{
+		ADD_STATE(5);
+		latch.count_down();
+		modm::fiber::yield();
+		ADD_STATE(6);
+		latch.count_down();
+		ADD_STATE(7);
+	});
+	modm::fiber::Scheduler::run();
+
+	TEST_ASSERT_TRUE(latch.try_wait());
+	TEST_ASSERT_EQUALS(states_pos, 7u);
+	TEST_ASSERT_EQUALS(states[0], 1);
+	TEST_ASSERT_EQUALS(states[1], 3);
+	TEST_ASSERT_EQUALS(states[2], 5);
+	TEST_ASSERT_EQUALS(states[3], 6);
+	TEST_ASSERT_EQUALS(states[4], 7);
+	TEST_ASSERT_EQUALS(states[5], 2);
+	TEST_ASSERT_EQUALS(states[6], 4);
+}
+
+namespace
+{
+
+modm::fiber::Barrier barrier{3};
+
+}  // namespace
+
+void
+FiberSynchronizationTest::testBarrier()
+{
+	states_pos = 0;
+	modm::Fiber fiberA(stack1, []()
+	{
+		for (uint8_t ii = 0; ii < 3; ii++) {
+			ADD_STATE(10 + ii);
+			barrier.arrive_and_wait();
+		}
+	});
+	modm::Fiber fiberB(stack2, []()
+	{
+		for (uint8_t ii = 0; ii < 3; ii++) {
+			ADD_STATE(10 + ii);
+			barrier.arrive_and_wait();
+		}
+	});
+	modm::Fiber fiberC(stack3, []()
+	{
+		ADD_STATE(10);
+		barrier.arrive_and_wait();
+		ADD_STATE(11);
+		// the following phases only wait for A and B
+		barrier.arrive_and_drop();
+	});
+	modm::fiber::Scheduler::run();
+
+	// no fiber enters the next phase before all arrived
+	TEST_ASSERT_EQUALS(states_pos, 8u);
+	for (size_t ii = 0; ii < 3; ii++) {
+		TEST_ASSERT_EQUALS(states[ii], 10);
+	}
+	for (size_t ii = 3; ii < 6; ii++) {
+		TEST_ASSERT_EQUALS(states[ii], 11);
+	}
+	TEST_ASSERT_EQUALS(states[6], 12);
+	TEST_ASSERT_EQUALS(states[7], 12);
+}
@@ -0,0 +1,249 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "rtos_queue_test.hpp"
+#include <modm/processing/rtos/queue.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+void
+RtosQueueTest::testMpmcQueue()
+{
+	// the capacity does not need to be a power of two
+	modm::rtos::MpmcQueue<int> queue(3);
+	TEST_ASSERT_EQUALS(queue.getMaxSize(), 3u);
+	TEST_ASSERT_TRUE(queue.isEmpty());
+	TEST_ASSERT_FALSE(queue.isFull());
+
+	int value{-1};
+	TEST_ASSERT_FALSE(queue.pop(value));
+	TEST_ASSERT_FALSE(queue.peek(value));
+	TEST_ASSERT_EQUALS(value, -1);
+
+	// multiple laps around the ring
+	int next{0};
+	for (int lap = 0; lap < 5; lap++)
+	{
+		TEST_ASSERT_TRUE(queue.push(next));
+		TEST_ASSERT_TRUE(queue.push(next + 1));
+		TEST_ASSERT_TRUE(queue.push(next + 2));
+		TEST_ASSERT_TRUE(queue.isFull());
+		TEST_ASSERT_FALSE(queue.push(100));
+		TEST_ASSERT_EQUALS(queue.getSize(), 3u);
+
+		TEST_ASSERT_TRUE(queue.peek(value));
+		TEST_ASSERT_EQUALS(value, next);
+		TEST_ASSERT_TRUE(queue.pop(value));
+		TEST_ASSERT_EQUALS(value, next);
+		TEST_ASSERT_EQUALS(queue.getSize(), 2u);
+
+		TEST_ASSERT_TRUE(queue.pop(value));
+		TEST_ASSERT_EQUALS(value, next + 1);
+		TEST_ASSERT_TRUE(queue.pop(value));
+		TEST_ASSERT_EQUALS(value, next + 2);
+		TEST_ASSERT_TRUE(queue.isEmpty());
+		TEST_ASSERT_FALSE(queue.pop(value));
+		next += 3;
+	}
+
+	// a capacity of zero is rounded up
+	modm::rtos::MpmcQueue<int> single(0);
+	TEST_ASSERT_EQUALS(single.getMaxSize(), 1u);
+	TEST_ASSERT_TRUE(single.push(1));
+	TEST_ASSERT_FALSE(single.push(2));
+}
+
+void
+RtosQueueTest::testMpmcDestructor()
+{
+	auto counter = std::make_shared<int>(0);
+	{
+		modm::rtos::MpmcQueue< std::shared_ptr<int> > queue(4);
+		for (int ii = 0; ii < 6; ii++)
+		{
+			TEST_ASSERT_TRUE(queue.push(counter));
+			std::shared_ptr<int> item;
+			if (ii & 1) {
+				TEST_ASSERT_TRUE(queue.pop(item));
+			}
+		}
+		// popping moves the item out of the queue
+		TEST_ASSERT_EQUALS(counter.use_count(), 4);
+	}
+	// the remaining items are destroyed with the queue
+	TEST_ASSERT_EQUALS(counter.use_count(), 1);
+}
+
+void
+RtosQueueTest::testMpmcPeek()
+{
+	constexpr int count = 10'000;
+	// long strings are allocated, so that copying a removed item would fail
+	const std::string prefix(64, 'x');
+	modm::rtos::MpmcQueue<std::string> queue(4);
+
+	std::thread producer([&]
+	{
+		for (int ii = 0; ii < count; ii++) {
+			while (not queue.push(prefix + std::to_string(ii))) std::this_thread::yield();
+		}
+	});
+	std::atomic<bool> done{false};
+	std::thread consumer([&]
+	{
+		std::string item;
+		for (int ii = 0; ii < count; ii++) {
+			while (not queue.pop(item)) std::this_thread::yield();
+		}
+		done = true;
+	});
+
+	// peeking concurrently with pop() always copies a complete item
+	std::string item;
+	bool valid{true};
+	while (not done)
+	{
+		if (queue.peek(item)) valid &= (item.compare(0, prefix.size(), prefix) == 0);
+	}
+	producer.join();
+	consumer.join();
+	TEST_ASSERT_TRUE(valid);
+	TEST_ASSERT_TRUE(queue.isEmpty());
+}
+
+void
+RtosQueueTest::testTimeout()
+{
+	modm::rtos::Queue<int> queue(2);
+	int value{0};
+
+	// a zero timeout never blocks
+	TEST_ASSERT_FALSE(queue.get(value, 0));
+	TEST_ASSERT_FALSE(queue.peek(value, 0));
+	TEST_ASSERT_TRUE(queue.append(1, 0));
+	TEST_ASSERT_TRUE(queue.appendFromInterrupt(2));
+	TEST_ASSERT_FALSE(queue.append(3, 0));
+	TEST_ASSERT_EQUALS(queue.getSize(), 2u);
+
+	// a full queue waits at least the timeout
+	auto start = std::chrono::steady_clock::now();
+	TEST_ASSERT_FALSE(queue.append(3, 10));
+	TEST_ASSERT_TRUE((std::chrono::steady_clock::now() - start) >= std::chrono::milliseconds(10));
+
+	TEST_ASSERT_TRUE(queue.peek(value, 10));
+	TEST_ASSERT_EQUALS(value, 1);
+	TEST_ASSERT_TRUE(queue.get(value, 10));
+	TEST_ASSERT_EQUALS(value, 1);
+	TEST_ASSERT_TRUE(queue.getFromInterrupt(value));
+	TEST_ASSERT_EQUALS(value, 2);
+
+	// an empty queue waits at least the timeout
+	start = std::chrono::steady_clock::now();
+	TEST_ASSERT_FALSE(queue.get(value, 10));
+	TEST_ASSERT_TRUE((std::chrono::steady_clock::now() - start) >= std::chrono::milliseconds(10));
+	TEST_ASSERT_EQUALS(queue.getSize(), 0u);
+}
+
+void
+RtosQueueTest::testPrepend()
+{
+	modm::rtos::Queue<int> queue(3);
+	int value{0};
+
+	TEST_ASSERT_TRUE(queue.append(1, 0));
+	TEST_ASSERT_TRUE(queue.prepend(0, 0));
+	TEST_ASSERT_TRUE(queue.prependFromInterrupt(-1));
+	TEST_ASSERT_EQUALS(queue.getSize(), 3u);
+
+	// the prepended items count towards the length
+	TEST_ASSERT_FALSE(queue.append(2, 0));
+	TEST_ASSERT_FALSE(queue.prepend(-2, 0));
+
+	TEST_ASSERT_TRUE(queue.peek(value, 0));
+	TEST_ASSERT_EQUALS(value, -1);
+	TEST_ASSERT_TRUE(queue.get(value, 0));
+	TEST_ASSERT_EQUALS(value, -1);
+
+	TEST_ASSERT_TRUE(queue.append(2, 0));
+	for (int expected = 0; expected <= 2; expected++)
+	{
+		TEST_ASSERT_TRUE(queue.get(value, 0));
+		TEST_ASSERT_EQUALS(value, expected);
+	}
+	TEST_ASSERT_FALSE(queue.get(value, 0));
+	TEST_ASSERT_EQUALS(queue.getSize(), 0u);
+}
+
+void
+RtosQueueTest::testBlocking()
+{
+	modm::rtos::Queue<int> queue(1);
+	int value{0};
+
+	// the consumer waits indefinitely until an item is appended
+	std::thread consumer([&] { queue.get(value); });
+	std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	TEST_ASSERT_TRUE(queue.append(42));
+	consumer.join();
+	TEST_ASSERT_EQUALS(value, 42);
+
+	// the producer waits until the item is removed
+	TEST_ASSERT_TRUE(queue.append(1));
+	std::thread producer([&] { queue.append(2, 1000); });
+	std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	TEST_ASSERT_TRUE(queue.get(value));
+	TEST_ASSERT_EQUALS(value, 1);
+	producer.join();
+	TEST_ASSERT_TRUE(queue.get(value, 0));
+	TEST_ASSERT_EQUALS(value, 2);
+}
+
+void
+RtosQueueTest::testThreads()
+{
+	constexpr int producers = 4;
+	constexpr int consumers = 2;
+	constexpr int count = 10'000;
+	modm::rtos::Queue<int> queue(16);
+
+	std::vector<std::thread> threads;
+	for (int ii = 0; ii < producers; ii++)
+	{
+		threads.emplace_back([&queue, ii]
+		{
+			for (int value = 1; value <= count; value++)
+				queue.append(ii * count + value);
+		});
+	}
+	std::atomic<int64_t> sum{0};
+	std::atomic<int> received{0};
+	for (int ii = 0; ii < consumers; ii++)
+	{
+		threads.emplace_back([&]
+		{
+			int value;
+			// the timeout ends the consumers after all items were received
+			while (queue.get(value, 100))
+			{
+				sum += value;
+				received++;
+			}
+		});
+	}
+	for (auto& thread : threads) thread.join();
+
+	constexpr int total = producers * count;
+	TEST_ASSERT_EQUALS(received.load(), total);
+	TEST_ASSERT_EQUALS(sum.load(), int64_t(total) * (total + 1) / 2);
+	TEST_ASSERT_EQUALS(queue.getSize(), 0u);
+}
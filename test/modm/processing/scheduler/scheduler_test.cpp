@@ -12,9 +12,14 @@
 // ----------------------------------------------------------------------------
 
 #include <modm/processing/scheduler/scheduler.hpp>
+#include <modm/architecture/detect.hpp>
 
 #include "scheduler_test.hpp"
 
+#ifdef MODM_OS_HOSTED
+#include <chrono>
+#endif
+
 // ----------------------------------------------------------------------------
 
 static unsigned int count = 1;
@@ -37,6 +42,34 @@ public:
 	uint8_t order;
 };
 
+class CountingTask : public modm::Scheduler::Task
+{
+public:
+	virtual void
+	run()
+	{
+		runs++;
+	}
+
+	uint32_t runs = 0;
+};
+
+static modm::Scheduler* removingScheduler;
+
+class RemovingTask : public modm::Scheduler::Task
+{
+public:
+	virtual void
+	run()
+	{
+		runs++;
+		removed = removingScheduler->removeTask(*this);
+	}
+
+	uint8_t runs = 0;
+	bool removed = false;
+};
+
 // ----------------------------------------------------------------------------
 
 void
@@ -90,3 +123,97 @@ SchedulerTest::testScheduler()
 	TEST_ASSERT_EQUALS(task3.order, 3);
 	TEST_ASSERT_EQUALS(task4.order, 1);
 }
+
+void
+SchedulerTest::testRemoveTask()
+{
+	modm::Scheduler scheduler;
+
+	CountingTask task1;
+	CountingTask task2;
+	RemovingTask task3;
+
+	scheduler.scheduleTask(task1, 2);
+	scheduler.scheduleTask(task2, 2);
+	removingScheduler = &scheduler;
+	scheduler.scheduleTask(task3, 1);
+
+	for (uint8_t ii = 0; ii < 4; ii++) {
+		scheduler.schedule();
+	}
+	TEST_ASSERT_EQUALS(task1.runs, 2u);
+	TEST_ASSERT_EQUALS(task2.runs, 2u);
+	// the task removed itself while it was running
+	TEST_ASSERT_EQUALS(task3.runs, 1);
+	TEST_ASSERT_TRUE(task3.removed);
+
+	TEST_ASSERT_TRUE(scheduler.removeTask(task1));
+	TEST_ASSERT_FALSE(scheduler.removeTask(task1));
+	TEST_ASSERT_FALSE(scheduler.removeTask(task3));
+
+	for (uint8_t ii = 0; ii < 4; ii++) {
+		scheduler.schedule();
+	}
+	TEST_ASSERT_EQUALS(task1.runs, 2u);
+	TEST_ASSERT_EQUALS(task2.runs, 4u);
+	TEST_ASSERT_EQUALS(task3.runs, 1);
+
+	TEST_ASSERT_TRUE(scheduler.removeTask(task2));
+}
+
+void
+SchedulerTest::testLongPeriods()
+{
+	modm::Scheduler scheduler;
+
+	// periods that cover every level of the timing wheel
+	const uint16_t periods[] = {1, 15, 16, 17, 255, 256, 4095, 4096, 4097, 30000, 65535};
+	CountingTask tasks[sizeof(periods) / sizeof(periods[0])];
+	for (uint8_t ii = 0; ii < sizeof(periods) / sizeof(periods[0]); ii++) {
+		scheduler.scheduleTask(tasks[ii], periods[ii], ii + 1);
+	}
+
+	for (uint32_t tick = 0; tick < 140000; tick++) {
+		scheduler.schedule();
+	}
+	for (uint8_t ii = 0; ii < sizeof(periods) / sizeof(periods[0]); ii++) {
+		TEST_ASSERT_EQUALS(tasks[ii].runs, 140000u / periods[ii]);
+	}
+
+	for (auto& task : tasks) {
+		TEST_ASSERT_TRUE(scheduler.removeTask(task));
+	}
+}
+
+void
+SchedulerTest::testTickCost()
+{
+#ifdef MODM_OS_HOSTED
+	// The cost of a tick must not grow with the number of tasks that are
+	// not due. A linear walk over all tasks is 100 times slower here.
+	static CountingTask tasks[1000];
+	const auto measure = [](uint16_t count)
+	{
+		modm::Scheduler scheduler;
+		for (uint16_t ii = 0; ii < count; ii++) {
+			scheduler.scheduleTask(tasks[ii], 65000 - ii);
+		}
+		const auto start = std::chrono::steady_clock::now();
+		for (uint16_t tick = 0; tick < 60000; tick++) {
+			scheduler.schedule();
+		}
+		const auto diff = std::chrono::steady_clock::now() - start;
+		for (uint16_t ii = 0; ii < count; ii++) {
+			scheduler.removeTask(tasks[ii]);
+		}
+		return std::chrono::duration<float, std::nano>(diff).count() / 60000;
+	};
+
+	measure(10);
+	const float cost10 = measure(10);
+	const float cost100 = measure(100);
+	const float cost1000 = measure(1000);
+	TEST_ASSERT_TRUE(cost100 < 10 * cost10);
+	TEST_ASSERT_TRUE(cost1000 < 10 * cost10);
+#endif
+}
@@ -0,0 +1,154 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "deadline_test.hpp"
+#include <modm/processing/timer.hpp>
+#include <modm-test/mock/clock.hpp>
+
+using namespace std::chrono_literals;
+using test_clock = modm_test::chrono::milli_clock;
+using test_precise_clock = modm_test::chrono::micro_clock;
+
+void
+DeadlineTest::setUp()
+{
+	test_clock::setTime(0);
+	test_precise_clock::setTime(0);
+}
+
+void
+DeadlineTest::testEmpty()
+{
+	modm::Deadline deadline;
+	TEST_ASSERT_TRUE(deadline.empty());
+	TEST_ASSERT_TRUE(deadline.remaining() == modm::Deadline::duration::max());
+
+	// stopped timers are ignored
+	modm::Timeout timeout;
+	modm::TimerWheel wheel;
+	deadline.add(timeout);
+	deadline.add(wheel);
+	TEST_ASSERT_TRUE(deadline.empty());
+
+	// returns immediately
+	deadline.idle();
+}
+
+void
+DeadlineTest::testTimeouts()
+{
+	modm::Timeout timeout{100ms};
+	modm::ShortTimeout short_timeout{50ms};
+	modm::PreciseTimeout precise_timeout{20'500us};
+
+	test_clock::setTime(10);
+	test_precise_clock::setTime(500);
+	{
+		modm::Deadline deadline;
+		deadline.add(timeout);
+		TEST_ASSERT_FALSE(deadline.empty());
+		TEST_ASSERT_EQUALS(deadline.remaining(), 90ms);
+		deadline.add(short_timeout);
+		TEST_ASSERT_EQUALS(deadline.remaining(), 40ms);
+		deadline.add(precise_timeout);
+		TEST_ASSERT_EQUALS(deadline.remaining(), 20ms);
+	}
+
+	// expired timeouts are due until they were executed
+	test_clock::setTime(60);
+	{
+		modm::Deadline deadline;
+		deadline.add(timeout);
+		deadline.add(short_timeout);
+		TEST_ASSERT_EQUALS(deadline.remaining(), 0ms);
+	}
+	TEST_ASSERT_TRUE(short_timeout.execute());
+	{
+		modm::Deadline deadline;
+		deadline.add(timeout);
+		deadline.add(short_timeout);
+		TEST_ASSERT_EQUALS(deadline.remaining(), 40ms);
+		// returns immediately after the deadline has passed
+		deadline.add(-5ms);
+		TEST_ASSERT_EQUALS(deadline.remaining(), 0ms);
+		deadline.idle();
+	}
+}
+
+void
+DeadlineTest::testPeriodicTimer()
+{
+	modm::PeriodicTimer timer{30ms};
+	modm::PrecisePeriodicTimer precise_timer{1500us};
+
+	test_clock::setTime(20);
+	{
+		modm::Deadline deadline;
+		deadline.add(timer);
+		TEST_ASSERT_EQUALS(deadline.remaining(), 10ms);
+	}
+	// periodic timers rearm on execution
+	test_clock::setTime(35);
+	TEST_ASSERT_EQUALS(timer.execute(), 1u);
+	{
+		modm::Deadline deadline;
+		deadline.add(timer);
+		TEST_ASSERT_EQUALS(deadline.remaining(), 25ms);
+		deadline.add(precise_timer);
+		TEST_ASSERT_EQUALS(deadline.remaining(), 1500us);
+	}
+}
+
+void
+DeadlineTest::testTimerWheel()
+{
+	modm::TimerWheel wheel;
+	modm::TimerWheel::Timer timer1, timer2;
+
+	wheel.start(timer1, 40ms);
+	wheel.start(timer2, 5000ms);
+	{
+		modm::Deadline deadline;
+		deadline.add(wheel);
+		TEST_ASSERT_EQUALS(deadline.remaining(), 40ms);
+	}
+
+	test_clock::setTime(40);
+	wheel.update();
+	{
+		// the wheel may need to be updated before the timer expires
+		modm::Deadline deadline;
+		deadline.add(wheel);
+		TEST_ASSERT_FALSE(deadline.empty());
+		TEST_ASSERT_TRUE(deadline.remaining() <= 4960ms);
+	}
+
+	wheel.stop(timer2);
+	{
+		modm::Deadline deadline;
+		deadline.add(wheel);
+		TEST_ASSERT_TRUE(deadline.empty());
+	}
+}
+
+void
+DeadlineTest::testTimePoint()
+{
+	test_clock::setTime(0xffff'fff0);
+	test_precise_clock::setTime(1000);
+
+	modm::Deadline deadline;
+	// time points of the wrapping clocks
+	deadline.add(modm::Clock::time_point{0x20ms});
+	TEST_ASSERT_EQUALS(deadline.remaining(), 48ms);
+	deadline.add(modm::PreciseClock::time_point{3000us});
+	TEST_ASSERT_EQUALS(deadline.remaining(), 2ms);
+	deadline.add(modm::PreciseClock::time_point{500us});
+	TEST_ASSERT_EQUALS(deadline.remaining(), 0ms);
+}
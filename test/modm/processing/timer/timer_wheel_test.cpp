@@ -0,0 +1,312 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "timer_wheel_test.hpp"
+#include <modm/processing/timer.hpp>
+#include <modm-test/mock/clock.hpp>
+
+using namespace std::chrono_literals;
+using test_clock = modm_test::chrono::milli_clock;
+
+namespace
+{
+
+struct Counter
+{
+	uint32_t count{0};
+	uint32_t time{0};
+
+	void
+	operator()()
+	{
+		count++;
+		time = modm::Clock::now().time_since_epoch().count();
+	}
+};
+
+}
+
+void
+TimerWheelTest::setUp()
+{
+	test_clock::setTime(0);
+}
+
+void
+TimerWheelTest::testOneShot()
+{
+	modm::TimerWheel wheel;
+	Counter counter;
+	modm::TimerWheel::Timer timer{[&counter] { counter(); }};
+
+	TEST_ASSERT_TRUE(wheel.empty());
+	TEST_ASSERT_FALSE(timer.isArmed());
+
+	wheel.start(timer, 10ms);
+	TEST_ASSERT_FALSE(wheel.empty());
+	TEST_ASSERT_TRUE(timer.isArmed());
+
+	test_clock::setTime(9);
+	TEST_ASSERT_EQUALS(wheel.update(), 0u);
+	TEST_ASSERT_EQUALS(counter.count, 0u);
+	TEST_ASSERT_FALSE(timer.isExpired());
+
+	test_clock::setTime(10);
+	TEST_ASSERT_EQUALS(wheel.update(), 1u);
+	TEST_ASSERT_EQUALS(counter.count, 1u);
+	TEST_ASSERT_TRUE(timer.isExpired());
+	TEST_ASSERT_FALSE(timer.isArmed());
+	TEST_ASSERT_TRUE(wheel.empty());
+
+	test_clock::setTime(1000);
+	TEST_ASSERT_EQUALS(wheel.update(), 0u);
+	TEST_ASSERT_EQUALS(counter.count, 1u);
+
+	// a zero duration expires on the next tick
+	wheel.start(timer, 0ms);
+	TEST_ASSERT_EQUALS(wheel.update(), 0u);
+	test_clock::setTime(1001);
+	TEST_ASSERT_EQUALS(wheel.update(), 1u);
+	TEST_ASSERT_EQUALS(counter.count, 2u);
+
+	// durations are rounded up to the next tick
+	wheel.start(timer, 1500us);
+	test_clock::setTime(1002);
+	TEST_ASSERT_EQUALS(wheel.update(), 0u);
+	test_clock::setTime(1003);
+	TEST_ASSERT_EQUALS(wheel.update(), 1u);
+}
+
+void
+TimerWheelTest::testPeriodic()
+{
+	modm::TimerWheel wheel;
+	Counter counter;
+	modm::TimerWheel::Timer timer{[&counter] { counter(); }};
+
+	wheel.startPeriodic(timer, 10ms);
+	TEST_ASSERT_EQUALS(timer.period(), 10ms);
+
+	for (uint32_t ii = 1; ii <= 100; ii++)
+	{
+		test_clock::setTime(ii);
+		wheel.update();
+		TEST_ASSERT_EQUALS(counter.count, ii / 10);
+	}
+	TEST_ASSERT_TRUE(timer.isArmed());
+
+	// missed periods call the callback once each and keep the period
+	test_clock::setTime(135);
+	TEST_ASSERT_EQUALS(wheel.update(), 3u);
+	TEST_ASSERT_EQUALS(counter.count, 13u);
+	test_clock::setTime(139);
+	TEST_ASSERT_EQUALS(wheel.update(), 0u);
+	test_clock::setTime(140);
+	TEST_ASSERT_EQUALS(wheel.update(), 1u);
+	TEST_ASSERT_EQUALS(counter.count, 14u);
+}
+
+void
+TimerWheelTest::testStop()
+{
+	modm::TimerWheel wheel;
+	Counter counter;
+	modm::TimerWheel::Timer timer1{[&counter] { counter(); }};
+	modm::TimerWheel::Timer timer2{[&counter] { counter(); }};
+
+	wheel.start(timer1, 10ms);
+	wheel.startPeriodic(timer2, 5000ms);
+	wheel.stop(timer1);
+	TEST_ASSERT_FALSE(timer1.isArmed());
+	TEST_ASSERT_FALSE(wheel.empty());
+
+	test_clock::setTime(100);
+	TEST_ASSERT_EQUALS(wheel.update(), 0u);
+
+	wheel.stop(timer2);
+	TEST_ASSERT_TRUE(wheel.empty());
+	test_clock::setTime(10000);
+	TEST_ASSERT_EQUALS(wheel.update(), 0u);
+	TEST_ASSERT_EQUALS(counter.count, 0u);
+
+	// stopping a stopped timer does nothing
+	wheel.stop(timer2);
+
+	// destructed timers are removed from the wheel
+	{
+		modm::TimerWheel::Timer timer3{[&counter] { counter(); }};
+		wheel.start(timer3, 10ms);
+		TEST_ASSERT_FALSE(wheel.empty());
+	}
+	TEST_ASSERT_TRUE(wheel.empty());
+	test_clock::setTime(10100);
+	TEST_ASSERT_EQUALS(wheel.update(), 0u);
+}
+
+void
+TimerWheelTest::testLongDelay()
+{
+	test_clock::setTime(4000);
+	modm::TimerWheel wheel;
+	Counter counter;
+	modm::TimerWheel::Timer timer1{[&counter] { counter(); }};
+	modm::TimerWheel::Timer timer2{[&counter] { counter(); }};
+
+	// timers in the coarser levels and beyond the range of the wheel
+	wheel.start(timer1, 300'000ms);
+	wheel.start(timer2, 40'000'000ms);
+
+	test_clock::setTime(303'999);
+	TEST_ASSERT_EQUALS(wheel.update(), 0u);
+	test_clock::setTime(304'000);
+	TEST_ASSERT_EQUALS(wheel.update(), 1u);
+	TEST_ASSERT_EQUALS(counter.time, 304'000u);
+
+	for (uint32_t time = 304'000; time < 40'010'000; time += 999)
+	{
+		test_clock::setTime(time);
+		wheel.update();
+		if (counter.count > 1) break;
+	}
+	TEST_ASSERT_EQUALS(counter.count, 2u);
+	TEST_ASSERT_TRUE(counter.time >= 40'004'000u);
+	TEST_ASSERT_TRUE(counter.time < 40'004'999u);
+
+	TEST_ASSERT_TRUE(wheel.empty());
+}
+
+void
+TimerWheelTest::testOverflow()
+{
+	test_clock::setTime(0xffff'ff00);
+	modm::TimerWheel wheel;
+	Counter counter;
+	modm::TimerWheel::Timer timer{[&counter] { counter(); }};
+
+	wheel.start(timer, 1000ms);
+	test_clock::setTime(743);
+	TEST_ASSERT_EQUALS(wheel.update(), 0u);
+	test_clock::setTime(744);
+	TEST_ASSERT_EQUALS(wheel.update(), 1u);
+
+	wheel.startPeriodic(timer, 100ms);
+	test_clock::setTime(9644);
+	TEST_ASSERT_EQUALS(wheel.update(), 89u);
+}
+
+namespace
+{
+
+struct Chain
+{
+	modm::TimerWheel& wheel;
+	modm::TimerWheel::Timer& self;
+	modm::TimerWheel::Timer& other;
+	uint32_t count{0};
+
+	void
+	operator()()
+	{
+		if (++count < 3)
+		{
+			// restart itself and stop the other timer expiring at the same tick
+			wheel.start(self, 10ms);
+			wheel.stop(other);
+		}
+	}
+};
+
+}
+
+void
+TimerWheelTest::testRestartFromCallback()
+{
+	modm::TimerWheel wheel;
+	modm::TimerWheel::Timer timer1, timer2;
+	Chain chain{wheel, timer1, timer2};
+	timer1.setCallback([&chain] { chain(); });
+
+	wheel.start(timer1, 10ms);
+	wheel.start(timer2, 10ms);
+	test_clock::setTime(10);
+	wheel.update();
+	TEST_ASSERT_EQUALS(chain.count, 1u);
+	TEST_ASSERT_TRUE(timer1.isArmed());
+	TEST_ASSERT_FALSE(timer2.isArmed());
+
+	test_clock::setTime(19);
+	TEST_ASSERT_EQUALS(wheel.update(), 0u);
+	test_clock::setTime(20);
+	TEST_ASSERT_EQUALS(wheel.update(), 1u);
+	// restarted timers start from the current time
+	test_clock::setTime(100);
+	TEST_ASSERT_EQUALS(wheel.update(), 1u);
+	TEST_ASSERT_EQUALS(chain.count, 3u);
+	TEST_ASSERT_TRUE(wheel.empty());
+
+	// a periodic timer can stop itself
+	Chain stopper{wheel, timer2, timer2};
+	timer2.setCallback([&stopper] { if (++stopper.count == 2) stopper.wheel.stop(stopper.self); });
+	wheel.startPeriodic(timer2, 5ms);
+	test_clock::setTime(200);
+	TEST_ASSERT_EQUALS(wheel.update(), 2u);
+	TEST_ASSERT_EQUALS(stopper.count, 2u);
+	TEST_ASSERT_FALSE(timer2.isArmed());
+}
+
+void
+TimerWheelTest::testExecute()
+{
+	modm::TimerWheel wheel;
+	modm::TimerWheel::Timer timer;
+
+	// timers without a callback can be polled
+	wheel.start(timer, 5ms);
+	TEST_ASSERT_FALSE(timer.execute());
+	test_clock::setTime(5);
+	TEST_ASSERT_FALSE(timer.execute());
+	wheel.update();
+	TEST_ASSERT_TRUE(timer.execute());
+	TEST_ASSERT_FALSE(timer.execute());
+	TEST_ASSERT_FALSE(timer.isExpired());
+
+	// restarting clears the expiration
+	wheel.start(timer, 5ms);
+	test_clock::setTime(10);
+	wheel.update();
+	TEST_ASSERT_TRUE(timer.isExpired());
+	wheel.start(timer, 5ms);
+	TEST_ASSERT_FALSE(timer.isExpired());
+	TEST_ASSERT_FALSE(timer.execute());
+}
+
+void
+TimerWheelTest::testManyTimers()
+{
+	modm::TimerWheel wheel;
+	uint32_t count{0};
+	static modm::TimerWheel::Timer timers[1000];
+	for (uint32_t ii = 0; ii < 1000; ii++)
+	{
+		timers[ii].setCallback([&count] { count++; });
+		wheel.start(timers[ii], std::chrono::milliseconds(1 + ii * 37));
+	}
+
+	// timer ii expires at 1 + ii * 37
+	bool correct{true};
+	for (uint32_t time = 1; time <= 37'000; time++)
+	{
+		test_clock::setTime(time);
+		wheel.update();
+		correct &= (count == std::min<uint32_t>(1000, (time - 1) / 37 + 1));
+	}
+	TEST_ASSERT_TRUE(correct);
+	TEST_ASSERT_EQUALS(count, 1000u);
+	TEST_ASSERT_TRUE(wheel.empty());
+}